@@ -0,0 +1,121 @@
+#ifndef BENCH_HPP___
+#define BENCH_HPP___
+
+#include <stdio.h>
+#include <stddef.h>
+#include <chrono>
+
+////////////////////////////////////////////////////////////////
+
+#if defined(__GNUC__) || defined(__clang__)
+# define BENCH_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+# define BENCH_NOINLINE __declspec(noinline)
+#else
+# define BENCH_NOINLINE
+#endif
+
+#if !defined(BENCH_ITERATIONS)
+# define BENCH_ITERATIONS 10000000
+#endif
+
+// Size of the stack region painted before measuring the stack usage.
+#if !defined(BENCH_STACK_PAINT_SIZE)
+# define BENCH_STACK_PAINT_SIZE 4096
+#endif
+
+#define BENCH_STACK_PAINT_BYTE 0xA5
+
+////////////////////////////////////////////////////////////////
+
+#define BENCH_FUNCTION_NAME(bench_suite_name, bench_name)  \
+  bench_ ## bench_suite_name ## _ ## bench_name
+
+#define BENCH_SUBSYS(bench_suite_name, bench_name)    \
+  void BENCH_FUNCTION_NAME(bench_suite_name, bench_name) ()
+
+#define BENCH_SUBSYS_DECLARE(bench_suite_name, bench_name) \
+  void BENCH_FUNCTION_NAME(bench_suite_name, bench_name) ()
+
+#define BENCH_RUN_SUBSYS(bench_suite_name, bench_name)  \
+  do {\
+    printf("[----------] [BEGIN] " #bench_suite_name " - " #bench_name "\n");\
+    BENCH_FUNCTION_NAME(bench_suite_name, bench_name)();\
+    printf("[----------] [END] " #bench_suite_name " - " #bench_name "\n\n");\
+    fflush(stdout);\
+  } while(0)
+
+#define BENCH_HEADER() \
+  printf("%-40s %12s %12s\n", "case", "ns/op", "stack(B)")
+
+#define BENCH_REPORT(name, ns_per_op, stack_bytes) \
+  printf("%-40s %12.2f %12u\n", name, (ns_per_op), static_cast<unsigned>(stack_bytes))
+
+////////////////////////////////////////////////////////////////
+
+// Keep the compiler from optimizing `value` away.
+template <typename T>
+inline void bench_do_not_optimize(T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "g"(&value) : "memory");
+#else
+  volatile T* p = &value;
+  (void)p;
+#endif
+}
+
+// Run `op` BENCH_ITERATIONS times, return nanoseconds per call.
+template <typename Op>
+inline double bench_time_ns(Op op)
+{
+  auto begin = std::chrono::steady_clock::now();
+  for (long i = 0; i < BENCH_ITERATIONS; ++i)
+    op();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - begin).count() / BENCH_ITERATIONS;
+}
+
+// Fill the stack region below the caller with a known pattern.
+BENCH_NOINLINE inline void bench_paint_stack()
+{
+  volatile unsigned char region[BENCH_STACK_PAINT_SIZE];
+  volatile unsigned char* p = region;
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : "+r"(p));
+#endif
+  for (size_t i = 0; i < BENCH_STACK_PAINT_SIZE; ++i)
+    p[i] = BENCH_STACK_PAINT_BYTE;
+}
+
+// Return how many bytes of the painted region have been overwritten.
+// The frame lies at the same address as the one of `bench_paint_stack`.
+BENCH_NOINLINE inline size_t bench_scan_stack()
+{
+  volatile unsigned char region[BENCH_STACK_PAINT_SIZE];
+  volatile unsigned char* p = region;
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : "+r"(p));
+#endif
+  size_t i = 0;
+  // The stack grows downwards, `region[0]` is the deepest byte.
+  while (i < BENCH_STACK_PAINT_SIZE && p[i] == BENCH_STACK_PAINT_BYTE)
+    ++i;
+  return BENCH_STACK_PAINT_SIZE - i;
+}
+
+BENCH_NOINLINE inline void bench_empty_op() {}
+
+// Peak stack usage of `op()` in bytes, excluding the cost of the call itself.
+inline size_t bench_stack_bytes(void (*op)())
+{
+  bench_paint_stack();
+  bench_empty_op();
+  size_t base = bench_scan_stack();
+  bench_paint_stack();
+  op();
+  size_t used = bench_scan_stack();
+  return used > base ? used - base : 0;
+}
+
+#endif // BENCH_HPP___
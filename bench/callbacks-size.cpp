@@ -0,0 +1,62 @@
+#include "embed/embed_function.hpp"
+#include <cstdio>
+
+// A program with many distinct callbacks, for the `size` target.
+// Each lambda below is a distinct target type of embed::function, so
+// the size of `.text` grows with the code instantiated per target type.
+// (Build it against another copy of the header to compare)
+
+#if !defined(BENCH_SIZE_CALLBACKS)
+# define BENCH_SIZE_CALLBACKS 200
+#endif
+
+using bench_size_cb_t = embed::function<int(int)>;
+
+static bench_size_cb_t g_callbacks[BENCH_SIZE_CALLBACKS];
+static volatile int g_seed = 1;
+
+// Store the callback `N`, as a separate registration function would.
+template <int N>
+static void bench_size_register()
+{
+    int k = g_seed + N;
+    g_callbacks[N - 1] = [k](int a) { return a * k + N; };
+}
+
+// The table of the registration functions. (Called through the pointers,
+// so that they are not inlined into each other)
+template <int N>
+struct bench_size_table
+{
+    static void fill(void (**table)())
+    {
+        table[N - 1] = &bench_size_register<N>;
+        bench_size_table<N - 1>::fill(table);
+    }
+};
+
+template <>
+struct bench_size_table<0>
+{
+    static void fill(void (**)()) {}
+};
+
+int main()
+{
+    static void (*registers[BENCH_SIZE_CALLBACKS])();
+    bench_size_table<BENCH_SIZE_CALLBACKS>::fill(registers);
+    for (int i = 0; i < BENCH_SIZE_CALLBACKS; ++i)
+        registers[i]();
+
+    // Copy, move and destroy every target, as a real program would.
+    int sum = 0;
+    for (int i = 0; i < BENCH_SIZE_CALLBACKS; ++i)
+    {
+        bench_size_cb_t copy = g_callbacks[i];
+        bench_size_cb_t moved = std::move(copy);
+        sum += moved(i);
+    }
+    std::printf("%d callbacks, sum %d\n", BENCH_SIZE_CALLBACKS, sum);
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "embed/embed_function.hpp"
+#include "bench.hpp"
+
+// Invocation through the type-erased invoker, with scalar arguments.
+
+struct benchUse__Pair_ {
+    int first;
+    int second;
+};
+
+static volatile int g_sink_int;
+static volatile float g_sink_float;
+static volatile double g_sink_double;
+
+using bench_void3_t = embed::function<void(int, int, float)>;
+using bench_int1_t = embed::function<int(int)>;
+using bench_double2_t = embed::function<double(double, double)>;
+using bench_pair_t = embed::function<int(benchUse__Pair_)>;
+
+static bench_void3_t g_void3;
+static bench_int1_t g_int1;
+static bench_double2_t g_double2;
+static bench_pair_t g_pair;
+
+BENCH_NOINLINE static void bench_op_void3()
+{
+    for (int i = 0; i < 64; ++i)
+        g_void3(i, i + 1, 0.5f);
+}
+
+BENCH_NOINLINE static void bench_op_int1()
+{
+    int acc = 0;
+    for (int i = 0; i < 64; ++i)
+        acc += g_int1(i);
+    g_sink_int = acc;
+}
+
+BENCH_NOINLINE static void bench_op_double2()
+{
+    double acc = 0.0;
+    for (int i = 0; i < 64; ++i)
+        acc += g_double2(acc, 1.0);
+    g_sink_double = acc;
+}
+
+BENCH_NOINLINE static void bench_op_pair()
+{
+    int acc = 0;
+    for (int i = 0; i < 64; ++i)
+        acc += g_pair(benchUse__Pair_{i, acc});
+    g_sink_int = acc;
+}
+
+static void bench_case(const char* name, void (*op)())
+{
+    // 64 calls per op.
+    double ns = bench_time_ns(op) / 64;
+    size_t stack = bench_stack_bytes(op);
+    BENCH_REPORT(name, ns, stack);
+}
+
+BENCH_SUBSYS(InvokeBench, main) {
+    g_void3 = [](int a, int b, float c) { g_sink_float = static_cast<float>(a + b) * c; };
+    g_int1 = [](int a) { return a * 3 + 1; };
+    g_double2 = [](double a, double b) { return a * 0.5 + b; };
+    g_pair = [](benchUse__Pair_ p) { return p.first ^ p.second; };
+
+    BENCH_HEADER();
+    bench_case("void(int, int, float)", &bench_op_void3);
+    bench_case("int(int)", &bench_op_int1);
+    bench_case("double(double, double)", &bench_op_double2);
+    bench_case("int(struct {int, int})", &bench_op_pair);
+}
@@ -0,0 +1,15 @@
+#include "bench.hpp"
+
+BENCH_SUBSYS_DECLARE(RelocateBench, main);
+BENCH_SUBSYS_DECLARE(InvokeBench, main);
+BENCH_SUBSYS_DECLARE(TableBench, main);
+
+int main()
+{
+
+    BENCH_RUN_SUBSYS(RelocateBench, main);
+    BENCH_RUN_SUBSYS(InvokeBench, main);
+    BENCH_RUN_SUBSYS(TableBench, main);
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include "embed/embed_function.hpp"
+#include "bench.hpp"
+
+// A small target with user-provided copy / move / destructor,
+// so that every lifecycle operation has to go through the manager.
+struct benchUse__NonTrivial_ {
+    int value;
+    explicit benchUse__NonTrivial_(int v) noexcept : value(v) {}
+    benchUse__NonTrivial_(const benchUse__NonTrivial_& o) noexcept : value(o.value) {}
+    benchUse__NonTrivial_(benchUse__NonTrivial_&& o) noexcept : value(o.value) {}
+    ~benchUse__NonTrivial_() noexcept { value = 0; bench_do_not_optimize(value); }
+    int operator()(int a) const { return a + value; }
+};
+
+using bench_fn_t = embed::function<int(int)>;
+
+static bench_fn_t g_fn1;
+static bench_fn_t g_fn2;
+static benchUse__NonTrivial_ g_functor(3);
+
+static void bench_reset()
+{
+    g_fn1 = benchUse__NonTrivial_(1);
+    g_fn2 = benchUse__NonTrivial_(2);
+}
+
+BENCH_NOINLINE static void bench_op_swap()
+{
+    g_fn1.swap(g_fn2);
+}
+
+BENCH_NOINLINE static void bench_op_move_assign()
+{
+    bench_fn_t tmp(benchUse__NonTrivial_(4));
+    g_fn1 = std::move(tmp);
+}
+
+BENCH_NOINLINE static void bench_op_copy_assign()
+{
+    g_fn1 = g_fn2;
+}
+
+BENCH_NOINLINE static void bench_op_copy_assign_empty()
+{
+    g_fn1 = nullptr;
+    g_fn1 = g_fn2;
+}
+
+BENCH_NOINLINE static void bench_op_functor_assign()
+{
+    g_fn1 = g_functor;
+}
+
+BENCH_NOINLINE static void bench_op_emplace()
+{
+    g_fn1.emplace<benchUse__NonTrivial_>(3);
+}
+
+static void bench_case(const char* name, void (*op)())
+{
+    bench_reset();
+    double ns = bench_time_ns(op);
+    bench_reset();
+    size_t stack = bench_stack_bytes(op);
+    BENCH_REPORT(name, ns, stack);
+}
+
+BENCH_SUBSYS(RelocateBench, main) {
+    BENCH_HEADER();
+    bench_case("swap", &bench_op_swap);
+    bench_case("move assign (construct + assign)", &bench_op_move_assign);
+    bench_case("copy assign (non-empty)", &bench_op_copy_assign);
+    bench_case("copy assign (empty)", &bench_op_copy_assign_empty);
+    bench_case("functor assign", &bench_op_functor_assign);
+    bench_case("emplace", &bench_op_emplace);
+}
@@ -0,0 +1,103 @@
+#include "embed/embed_function.hpp"
+#include "bench.hpp"
+
+// A sweep over many callbacks: an array of embed::Fn against
+// embed::function_table (structure-of-arrays).
+
+#if !defined(BENCH_TABLE_CALLS)
+# define BENCH_TABLE_CALLS 20000000
+#endif
+
+#define BENCH_TABLE_MAX 1000000
+
+using bench_cb_t = embed::function<void(int&), 16>;
+using bench_fast_cb_t = embed::fast_function<void(int&), 16>;
+using bench_table_t = embed::function_table<void(int&), 16, BENCH_TABLE_MAX>;
+
+static bench_cb_t g_array[BENCH_TABLE_MAX];
+static bench_fast_cb_t g_fast_array[BENCH_TABLE_MAX];
+static bench_table_t g_table;
+static size_t g_count;
+static volatile int g_sink_int;
+
+static void bench_cb_double(int& acc) { acc *= 2; }
+
+// Four target types, so the indirect calls do not all go to one place.
+template <typename Fn>
+static Fn bench_make_cb(size_t i)
+{
+    int a = static_cast<int>(i);
+    switch (i % 4) {
+    case 0: return [a](int& acc) { acc += a; };
+    case 1: return [a](int& acc) { acc ^= a; };
+    case 2: { double d = 0.5 * a; return [a, d](int& acc) { acc += a - static_cast<int>(d); }; }
+    default: return bench_cb_double;
+    }
+}
+
+static void bench_fill(size_t count)
+{
+    g_count = count;
+    g_table.clear();
+    for (size_t i = 0; i < BENCH_TABLE_MAX; ++i) {
+        g_array[i] = nullptr;
+        g_fast_array[i] = nullptr;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        g_array[i] = bench_make_cb<bench_cb_t>(i);
+        g_fast_array[i] = bench_make_cb<bench_fast_cb_t>(i);
+        g_table.push_back(bench_make_cb<bench_cb_t>(i));
+    }
+}
+
+BENCH_NOINLINE static void bench_op_array()
+{
+    int acc = 0;
+    for (size_t i = 0; i < g_count; ++i)
+        g_array[i](acc);
+    g_sink_int = acc;
+}
+
+BENCH_NOINLINE static void bench_op_fast_array()
+{
+    int acc = 0;
+    for (size_t i = 0; i < g_count; ++i)
+        g_fast_array[i](acc);
+    g_sink_int = acc;
+}
+
+BENCH_NOINLINE static void bench_op_table()
+{
+    int acc = 0;
+    g_table.invoke_all(acc);
+    g_sink_int = acc;
+}
+
+static void bench_case(const char* name, void (*op)())
+{
+    long sweeps = static_cast<long>(BENCH_TABLE_CALLS / g_count);
+    op(); // warm up
+    auto begin = std::chrono::steady_clock::now();
+    for (long i = 0; i < sweeps; ++i)
+        op();
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - begin).count()
+        / (static_cast<double>(sweeps) * static_cast<double>(g_count));
+    BENCH_REPORT(name, ns, bench_stack_bytes(op));
+}
+
+BENCH_SUBSYS(TableBench, main) {
+    static const size_t counts[] = { 10000, 100000, 1000000 };
+    char name[64];
+
+    BENCH_HEADER();
+    for (size_t n = 0; n < sizeof(counts) / sizeof(counts[0]); ++n) {
+        bench_fill(counts[n]);
+        snprintf(name, sizeof(name), "array of function, %zu", counts[n]);
+        bench_case(name, &bench_op_array);
+        snprintf(name, sizeof(name), "array of fast_function, %zu", counts[n]);
+        bench_case(name, &bench_op_fast_array);
+        snprintf(name, sizeof(name), "function_table, %zu", counts[n]);
+        bench_case(name, &bench_op_table);
+    }
+}
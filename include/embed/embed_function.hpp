@@ -113,14 +113,27 @@ SOFTWARE.
 /// @note User can customize following configs
 
 /**
- * When fast invocation is enabled, the rate of function calls increases
- * by approximately 50%, which is consistent with the invocation overhead
- * of `std::function`. With fast-call enabled, each instance of 
- * `embed::function` uses an extra pointer-sized RAM (In the fast mode,
- * it occupies a total of two pointer sizes plus the buffer size of RAM space).
+ * When fast invocation is enabled, the invoker is stored in the instance,
+ * which saves the load of the invoker from the manager table on each call.
+ * This is consistent with the invocation overhead of `std::function`.
+ * With fast-call enabled, each instance of `embed::function` uses an
+ * extra pointer-sized RAM (In the fast mode, it occupies a total of
+ * two pointer sizes plus the buffer size of RAM space).
+ * This is only the default of `embed::function`. Use `embed::fast_function`
+ * or `embed::compact_function` to choose the layout per type.
  */
 #define EMBED_FN_NEED_FAST_CALL     false
 
+/**
+ * When the empty sentinel is enabled, an empty embed::Fn does not hold
+ * `nullptr`, but points at a static sentinel manager (and invoker) that
+ * routes the call to `bad_function_call_handler` (or throws
+ * `bad_function_call`). Then `operator()` is one unconditional indirect
+ * call without compare and branch, and `is_empty()` compares against
+ * the sentinel instead of `nullptr`.
+ */
+#define EMBED_FN_EMPTY_SENTINEL     false
+
 // Assert that the wrapped callable object does not throw exceptions.
 #define EMBED_FN_NOTHROW_CALLABLE   false
 
@@ -132,6 +145,16 @@ SOFTWARE.
 // Disable the warnings of embed::Fn
 #define EMBED_FN_NO_WARING          false
 
+// The number of managers (distinct target types, plus the empty one)
+// that each manager table of embed::IndexedFn can register.
+#define EMBED_FN_INDEX_CAPACITY     64
+
+// How many entries ahead `embed::function_table` prefetches the buffer
+// while it invokes the entries in order. 0 (default) disables the prefetch,
+// because a hardware prefetcher already follows the in-order sweep. It may
+// help on a core with a data cache but without a stream prefetcher.
+#define EMBED_FN_TABLE_PREFETCH     0
+
 ////////////////////////////////////////////////////////////////
 
 
@@ -217,6 +240,28 @@ SOFTWARE.
 # endif
 #endif
 
+/// @c EMBED_CXX20_CONSTEXPR
+#ifndef EMBED_CXX20_CONSTEXPR
+# if EMBED_CXX_VERSION >= 202002L
+#  define EMBED_CXX20_CONSTEXPR constexpr
+# else
+#  define EMBED_CXX20_CONSTEXPR
+# endif
+#endif
+
+/// @c EMBED_IS_CONSTANT_EVALUATED
+/// @brief `true` in the constant evaluation. (Always `false` before C++20,
+/// where embed::Fn is not usable in the constant evaluation)
+#ifndef EMBED_IS_CONSTANT_EVALUATED
+# if EMBED_CXX_VERSION >= 202002L && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#  define EMBED_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+# elif EMBED_CXX_VERSION >= 202002L && EMBED_HAS_BUILTIN(__builtin_is_constant_evaluated)
+#  define EMBED_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+# else
+#  define EMBED_IS_CONSTANT_EVALUATED() false
+# endif
+#endif
+
 /// @c EMBED_FN_CASE_NOEXCEPT
 /// @brief Only when C++ version is greater than C++17,
 /// c++ exception is disabled, and user need nothrow callable
@@ -229,6 +274,20 @@ SOFTWARE.
 # endif
 #endif
 
+/// @c EMBED_FN_CASE_NOEXCEPT_IF(cond)
+/// @brief Same as @b EMBED_FN_CASE_NOEXCEPT, but also `noexcept` when
+/// `cond` is true, i.e. the Signature is `noexcept` (only since C++17,
+/// before that the noexcept-specification is not a part of the type).
+#ifndef EMBED_FN_CASE_NOEXCEPT_IF
+# if EMBED_CXX_VERSION >= 201703L && EMBED_FN_NOTHROW_CALLABLE && !EMBED_CXX_ENABLE_EXCEPTION
+#  define EMBED_FN_CASE_NOEXCEPT_IF(cond) noexcept
+# elif EMBED_CXX_VERSION >= 201703L
+#  define EMBED_FN_CASE_NOEXCEPT_IF(cond) noexcept(cond)
+# else
+#  define EMBED_FN_CASE_NOEXCEPT_IF(cond)
+# endif
+#endif
+
 /// @c EMBED_INLINE
 #ifndef EMBED_INLINE
 # if defined(__GNUC__) || defined(__clang__) || defined(__TASKING__)
@@ -290,6 +349,17 @@ SOFTWARE.
 # endif
 #endif
 
+/// @c EMBED_PREFETCH(address)
+#ifndef EMBED_PREFETCH
+# if defined(__GNUC__) || defined(__clang__)
+#  define EMBED_PREFETCH(address) __builtin_prefetch(address)
+# elif EMBED_HAS_BUILTIN(__builtin_prefetch)
+#  define EMBED_PREFETCH(address) __builtin_prefetch(address)
+# else
+#  define EMBED_PREFETCH(address) ((void)(address))
+# endif
+#endif
+
 /// @c EMBED_UNREACHABLE()
 #ifndef EMBED_UNREACHABLE
 # if defined(_MSC_VER)
@@ -323,6 +393,8 @@ SOFTWARE.
 #  include <functional> // std::bad_function_call
 #  include <type_traits>
 #  include <exception>
+#  include <atomic> // std::atomic (embed::fixed_block_pool)
+#  include <cstdint> // std::uint32_t (embed::IndexedFn)
 # else
 /// @brief In some extreme cases, users cannot use standard header files.
 /// Here, alternative solutions are provided.
@@ -343,6 +415,13 @@ namespace embed { namespace detail {
   // the default buffer size for `embed::Fn`.
   constexpr std::size_t FnDefaultBufSize = (1 * sizeof(void*));
 
+  // the default call mode for `embed::Fn`. (DO NOT modify here,
+  // use the macro `EMBED_FN_NEED_FAST_CALL` instead)
+  constexpr bool FnDefaultFastCall = static_cast<bool>(EMBED_FN_NEED_FAST_CALL);
+
+  // the default buffer alignment for `embed::Fn`. (pointer alignment)
+  constexpr std::size_t FnDefaultAlign = alignof(void*);
+
   // The callback function is to handle the `bad_function_call`
   // only when the C++ exception is disabled.
   [[noreturn]] EMBED_UNUSED inline void bad_function_call_handler() noexcept
@@ -367,6 +446,31 @@ namespace embed { namespace detail {
     std::terminate(); // Terminate the program
   }
 
+  // The callback function is to handle the case that a manager table of
+  // embed::IndexedFn is full (see `EMBED_FN_INDEX_CAPACITY`).
+  [[noreturn]] EMBED_UNUSED inline void index_exhausted_handler() noexcept
+  {
+    /// Your can deal with the full manager table here.
+    /// Or you can just ignore this function, and use
+    /// @e `std::set_terminate` instead.
+    /// @example std::set_terminate(handle_reset);
+
+    std::terminate(); // Terminate the program
+  }
+
+  // The callback function is to handle the case that the pool of
+  // `embed::spill_function` has no free block for an oversized target.
+  [[noreturn]] EMBED_UNUSED inline void pool_exhausted_handler() noexcept
+  {
+    /// Your can deal with the exhausted pool here, the high-water mark
+    /// of the pool tells how many blocks were needed.
+    /// Or you can just ignore this function, and use
+    /// @e `std::set_terminate` instead.
+    /// @example std::set_terminate(handle_reset);
+
+    std::terminate(); // Terminate the program
+  }
+
 } } // end namespace embed::detail
 ////////////////////////////////////////////////////////////////
 
@@ -385,20 +489,50 @@ namespace embed { namespace detail {
   F_(, volatile, &&)                        \
   F_(const, volatile, &&)
 
-// Helper macro for switch-case
-# if ( EMBED_FN_NEED_FAST_CALL == false )
-#  define EMBED_FN_SWITCH_EXPECT(cond,val) \
-  EMBED_SWITCH_EXPECT(cond,val)
-# else
-#  define EMBED_FN_SWITCH_EXPECT(cond,val) (cond)
-# endif
-
 namespace embed EMBED_ABI_VISIBILITY(default)
 {
   // declare ahead
-  template <typename Signature, std::size_t BufSize>
+  template <typename Signature, std::size_t BufSize,
+    bool FastCall = detail::FnDefaultFastCall,
+    std::size_t Align = detail::FnDefaultAlign,
+    typename Pool = void>
   class Fn;
 
+  template <typename Signature, std::size_t BufSize,
+    bool FastCall = detail::FnDefaultFastCall>
+  class MoveOnlyFn;
+
+  template <typename Signature, std::size_t BufSize,
+    bool FastCall = detail::FnDefaultFastCall>
+  class NonnullFn;
+
+  template <std::size_t BufSize, typename... Signatures>
+  class OverloadFn;
+
+  template <typename Signature, std::size_t BufSize,
+    bool FastCall = detail::FnDefaultFastCall>
+  class TrivialFn;
+
+  template <typename Signature, std::size_t BufSize,
+    typename Index = std::uint32_t, std::size_t Align = alignof(Index)>
+  class IndexedFn;
+
+  template <typename Signature, std::size_t BufSize, std::size_t Capacity>
+  class function_table;
+
+  /// @brief Tag type to construct the target of embed::Fn in place.
+  /// (Same as `std::in_place_type_t`, which is only available since C++17)
+  template <typename T>
+  struct in_place_type_t
+  {
+    explicit in_place_type_t() = default;
+  };
+
+#if EMBED_CXX_VERSION >= 201703L
+  template <typename T>
+  inline constexpr in_place_type_t<T> in_place_type{};
+#endif
+
 namespace detail {
 
 #if defined(EMBED_NO_STD_HEADER)
@@ -448,8 +582,11 @@ namespace detail {
   }
 
   /// @c FnBufType
-  /// @brief Anchor the size of the objects that the embed::Fn can store.
-  template <std::size_t BufSize>
+  /// @brief Anchor the size and the alignment of the objects that
+  /// the embed::Fn can store. (at least the pointer alignment, unless
+  /// a smaller `Align` is given, e.g. by embed::IndexedFn)
+  template <std::size_t BufSize, std::size_t Align = FnDefaultAlign,
+    bool = ( Align >= FnDefaultAlign )>
   union FnBufType
   {
     void*       vPtr;
@@ -457,7 +594,19 @@ namespace detail {
     void (* fPtr) ();
 
     static_assert(BufSize > 0, "embed::Fn requires the BufSize greater than 0");
-    char        buf[BufSize];
+    static_assert(Align > 0 && (Align & (Align - 1)) == 0,
+      "embed::Fn requires the Align to be a power of 2");
+    alignas(Align) char buf[BufSize];
+  };
+
+  // The buffer aligned less than a pointer. (No pointer anchors)
+  template <std::size_t BufSize, std::size_t Align>
+  union FnBufType<BufSize, Align, false>
+  {
+    static_assert(BufSize > 0, "embed::Fn requires the BufSize greater than 0");
+    static_assert(Align > 0 && (Align & (Align - 1)) == 0,
+      "embed::Fn requires the Align to be a power of 2");
+    alignas(Align) char buf[BufSize];
   };
 
   /// @c EMBED_LAUNDER(x)
@@ -489,7 +638,7 @@ namespace detail {
    * Even if the EMBED_ALIAS does not exist, the reuse of the FnFunctor's
    * memory and the subsequent use of M_access for access are well-defined.
    */
-  template <std::size_t BufSize>
+  template <std::size_t BufSize, std::size_t Align = FnDefaultAlign>
   union EMBED_ALIAS FnFunctor
   {
     // non-volatile
@@ -518,8 +667,11 @@ namespace detail {
     EMBED_INLINE const volatile T& M_access() volatile const noexcept
     { return *EMBED_LAUNDER( static_cast<const volatile T*>(M_access()) ); }
 
-    FnBufType<BufSize>    M_unused;
-    char                  M_pod_data[sizeof(FnBufType<BufSize>)];
+    // The first member, so that `FnFunctor{}` makes it active. (In the
+    // constant evaluation, its first byte flags a stateless target of
+    // embed::Fn, which is not stored here. See `M_has_target`)
+    char                      M_pod_data[sizeof(FnBufType<BufSize, Align>)];
+    FnBufType<BufSize, Align> M_unused;
   };
 
   /// @c FnToolBox
@@ -528,48 +680,62 @@ namespace detail {
   {
   public:
 
-    // cooperate with M_manager in FnManagerCopyable
-    enum FunctorManagerOpCode {
-      OP_clone_functor,     // Clone the M_functor
-      OP_move_functor,      // Move the M_functor
-      OP_destroy_functor,   // Destroy the M_functor
-
-#if ( EMBED_FN_NEED_FAST_CALL == false )
-      // M_invoker is not a member of embed::Fn in this mode,
-      // so use OP_get_invoker to get it.
-      OP_get_invoker,
-#endif
-    };
-
     // embed::Fn need some type traits that don't exist in C++11.
     /// @c FnTraits is aimed to provide these traits.
     struct FnTraits;
 
+    /// @c FnManagerTable is the constant descriptor that `M_manager`
+    /// points at. There is one per functor type, holding the entries
+    /// to invoke / clone / move / destroy the `M_functor`.
+    /// (No clone entry for embed::MoveOnlyFn)
+    template <typename Invoker_Type, typename FnFunctor_Qualifier,
+      bool Is_copyable = true>
+    struct FnManagerTable;
+
     /// @c FnInvoker is aimed to help Fn call the functor.
-    /// When @b EMBED_FN_NEED_FAST_CALL is false, 
-    /// @c FnManagerCopyable, @c FnManagerMoveOnly
-    /// will help Fn call the functor instead of FnInvoker,
-    /// which will save the RAM, but is slower than FnInvoker.
+    /// In the compact layout, Fn does not store
+    /// the invoker itself, but loads it from the `FnManagerTable`,
+    /// which will save the RAM, but costs one more load per call.
     template <typename Signature, typename Functor,
-      std::size_t BufSize, bool Is_volatile, bool Is_rref>
+      std::size_t BufSize, bool Is_volatile, bool Is_rref, bool Is_noexcept,
+      std::size_t Align = FnDefaultAlign>
     struct FnInvoker;
 
     // embed::Fn will forget the type of Functor
     /// @c FnManagerCopyable is aimed to remember the type, 
     /// help Fn manage copyable functor.
     template <typename Signature, typename Functor,
-      std::size_t BufSize, bool Is_volatile, bool Is_rref>
+      std::size_t BufSize, bool Is_volatile, bool Is_rref, bool Is_noexcept,
+      std::size_t Align = FnDefaultAlign>
     struct FnManagerCopyable;
 
     // embed::Fn need to wrap non-copyable callable object.
     /// @c FnManagerMoveOnly is aimed to help Fn manage move-only functor.
     template <typename Signature, typename Functor,
-      std::size_t BufSize, bool Is_volatile, bool Is_rref>
+      std::size_t BufSize, bool Is_volatile, bool Is_rref, bool Is_noexcept,
+      std::size_t Align = FnDefaultAlign>
     struct FnManagerMoveOnly;
 
+    // embed::MoveOnlyFn never copies its target.
+    /// @c FnManagerRelocatable is aimed to help embed::MoveOnlyFn manage
+    /// any functor, without a clone entry.
+    template <typename Signature, typename Functor,
+      std::size_t BufSize, bool Is_volatile, bool Is_rref, bool Is_noexcept,
+      std::size_t Align = FnDefaultAlign>
+    struct FnManagerRelocatable;
+
     template <typename Signature, typename Functor,
-      std::size_t BufSize, bool Is_volatile, bool Is_rref>
+      std::size_t BufSize, bool Is_volatile, bool Is_rref, bool Is_noexcept,
+      std::size_t Align = FnDefaultAlign>
     struct FnManagerHelper;
+
+    /// @c FnEmptyManager is the sentinel that an empty Fn points at,
+    /// only used when @b EMBED_FN_EMPTY_SENTINEL is true. (And always
+    /// used by a moved-from embed::NonnullFn.)
+    template <typename Signature, std::size_t BufSize,
+      bool Is_volatile, bool Is_noexcept, bool Is_copyable = true,
+      std::size_t Align = FnDefaultAlign>
+    struct FnEmptyManager;
   };
 
 
@@ -580,14 +746,29 @@ namespace detail {
   struct FnToolBox::FnTraits
   {
     /// @e aligned_buf_size
-    template <std::size_t BufSize>
+    /// Round up to a multiple of `MinUnit` (default: the pointer size),
+    /// or of `Align`, if larger.
+    template <std::size_t BufSize, std::size_t Align = sizeof(void*),
+      std::size_t MinUnit = sizeof(void*)>
     struct aligned_buf_size
     {
+      static constexpr std::size_t unit = (Align > MinUnit) ? Align : MinUnit;
+
       // round up to an integer
-      static constexpr std::size_t value = (BufSize == 0) ? sizeof(void*) :
-        ((BufSize - 1) / sizeof(void*) + 1) * sizeof(void*);
+      static constexpr std::size_t value = (BufSize == 0) ? unit :
+        ((BufSize - 1) / unit + 1) * unit;
     };
 
+    /// @e fits_buffer
+    // `true` if the `Functor` can be stored in the buffer of embed::Fn.
+    template <typename Functor, std::size_t BufSize, std::size_t Align>
+    struct fits_buffer
+    : public std::integral_constant<bool,
+      sizeof(Functor) <= sizeof(FnBufType<BufSize, Align>)
+      && alignof(Functor) <= alignof(FnBufType<BufSize, Align>)
+      && (sizeof(Functor) % alignof(Functor) == 0)
+    > {};
+
     // The behavior of `void_t` is incorrect in the outdated GCC compiler.
     // So we use `make_void` to correct the behavior of `void_t`.
     // See https://www.open-std.org/jtc1/sc22/wg21/docs/cwg_defects.html#1558
@@ -600,6 +781,56 @@ namespace detail {
       typename std::remove_reference<T>::type
     >::type;
 
+    /// @e invoke_param_t
+    // The type of an argument crossing the type-erased invoker.
+    // Small trivially copyable arguments (int, float, pointers, small PODs)
+    // are passed by value, so that they stay in registers across the
+    // indirect call. Others are passed by reference.
+    template <typename T>
+    using invoke_param_t = typename std::conditional<
+      !std::is_reference<T>::value
+      && std::is_trivially_copyable<T>::value
+      && std::is_move_constructible<T>::value
+      && ( sizeof(T) <= 2 * sizeof(void*) ),
+      T, T&&
+    >::type;
+
+    /// @e is_stateless_target
+    // An empty, trivially copyable and trivially default constructible
+    // class (captureless lambda, `embed::nontype<&func>`, ...) needs no
+    // storage: the invoker calls a fresh object. So the embed::Fn can be
+    // constructed, copied and invoked in constant evaluation. (Since C++20)
+    template <typename Functor>
+    struct is_stateless_target
+    {
+#if EMBED_CXX_VERSION >= 202002L
+      static constexpr bool value = std::is_empty<Functor>::value
+        && std::is_trivially_copyable<Functor>::value
+        && std::is_trivially_constructible<Functor>::value;
+#else
+      static constexpr bool value = false;
+#endif
+    };
+
+    /// @e fresh_target
+    // Stands for a stateless `Functor` that is not stored, because it is
+    // constructed in constant evaluation. Its invoker calls a fresh object
+    // of `Functor`. A stateless target built at runtime is stored and
+    // called as any other target.
+    template <typename Functor>
+    struct fresh_target
+    {
+      using type = Functor;
+    };
+
+    template <typename T>
+    struct is_fresh_target : public std::false_type
+    { using target_type = T; };
+
+    template <typename Functor>
+    struct is_fresh_target<fresh_target<Functor>> : public std::true_type
+    { using target_type = Functor; };
+
     /// @brief trigger the SFINAE
     class failure_type {};
 
@@ -1083,14 +1314,14 @@ namespace detail {
     /// @e is_similar_Fn
     /// @brief check if two Fn are similar.
     /// "Similar" means the function signature is the same, but may have different buffer size.
+    /// (The buffer size is checked by `is_Fn_and_widening`.)
     template <
-      typename SelfRet, typename SelfArgs_package, std::size_t SelfArgNum, std::size_t SelfBuf,
-      typename OtherRet, typename OtherArgs_package, std::size_t OtherArgNum, std::size_t OtherBuf>
+      typename SelfRet, typename SelfArgs_package, std::size_t SelfArgNum,
+      typename OtherRet, typename OtherArgs_package, std::size_t OtherArgNum>
     struct is_similar_Fn
     {
       static constexpr bool value = 
-        ( aligned_buf_size<SelfBuf>::value == aligned_buf_size<OtherBuf>::value )
-        && results_are_same<OtherRet, SelfRet>::value
+        results_are_same<OtherRet, SelfRet>::value
         && ( SelfArgNum == OtherArgNum )
         && arguments_are_same<SelfArgs_package, OtherArgs_package, SelfArgNum>::value;
     };
@@ -1176,44 +1407,75 @@ namespace detail {
     template <typename Signature> struct unwrap_signature
     {
       static_assert(!std::is_void<void_t<Signature>>::value, /* always false */
-        "The Signature must be like `Ret(Args...) [const | volatile | & | &&]`."
+        "The Signature must be like `Ret(Args...) [const | volatile | & | &&] [noexcept]`."
         " And your signature format is incorrect.");
     };
 
-#define EMBED_FN_OVERLOAD_UNWRAP_SIGNATURE(C, V, REF)               \
+#define EMBED_FN_OVERLOAD_UNWRAP_SIGNATURE_IMPL(C, V, REF, NOEXC)      \
     template <typename RetType, typename... ArgsType>               \
-    struct unwrap_signature<RetType(ArgsType...) C V REF> {         \
+    struct unwrap_signature<RetType(ArgsType...) C V REF NOEXC> {   \
       using ret = RetType;                                          \
       using args = args_package<ArgsType...>;                       \
       static constexpr std::size_t arg_num = sizeof... (ArgsType);  \
       using pure_sig = RetType(ArgsType...);                        \
     };
 
+#define EMBED_FN_OVERLOAD_UNWRAP_SIGNATURE(C, V, REF)               \
+    EMBED_FN_OVERLOAD_UNWRAP_SIGNATURE_IMPL(C, V, REF, )
+
     // unwrap_signature for different kinds of signature.(const / volatile / {& | &&})
     EMBED_FN_GENERATE_CODE_C_V_REF(EMBED_FN_OVERLOAD_UNWRAP_SIGNATURE)
 
 #undef EMBED_FN_OVERLOAD_UNWRAP_SIGNATURE
 
+#if EMBED_CXX_VERSION >= 201703L
+# define EMBED_FN_OVERLOAD_UNWRAP_SIGNATURE(C, V, REF)              \
+    EMBED_FN_OVERLOAD_UNWRAP_SIGNATURE_IMPL(C, V, REF, noexcept)
+
+    // unwrap_signature for the noexcept signature. (Since C++17)
+    EMBED_FN_GENERATE_CODE_C_V_REF(EMBED_FN_OVERLOAD_UNWRAP_SIGNATURE)
+
+# undef EMBED_FN_OVERLOAD_UNWRAP_SIGNATURE
+#endif
+
+#undef EMBED_FN_OVERLOAD_UNWRAP_SIGNATURE_IMPL
+
     // get_signature_qualifier
     template <typename Signature>
     struct get_signature_qualifier;
 
-#define EMBED_FN_OVERLOAD_GET_SIGNATURE_QUALIFIER(C, V, REF)                    \
+#define EMBED_FN_OVERLOAD_GET_SIGNATURE_QUALIFIER_IMPL(C, V, REF, NOEXC, NOEXC_B) \
     template <typename Ret, typename... Args>                                   \
-    struct get_signature_qualifier<Ret(Args...) C V REF>                        \
+    struct get_signature_qualifier<Ret(Args...) C V REF NOEXC>                  \
     {                                                                           \
       static constexpr bool is_const = std::is_const<int C>::value;             \
       static constexpr bool is_volatile = std::is_volatile<int V>::value;       \
       static constexpr bool is_lref = std::is_lvalue_reference<int REF>::value; \
-      static constexpr bool is_rref = std::is_lvalue_reference<int REF>::value; \
+      static constexpr bool is_rref = std::is_rvalue_reference<int REF>::value; \
+      static constexpr bool is_noexcept = NOEXC_B;                              \
     };
 
+#define EMBED_FN_OVERLOAD_GET_SIGNATURE_QUALIFIER(C, V, REF)                    \
+    EMBED_FN_OVERLOAD_GET_SIGNATURE_QUALIFIER_IMPL(C, V, REF, , false)
+
     // Use the macro to generate code for different kinds of signature.
     // (const / volatile / {& | &&})
     EMBED_FN_GENERATE_CODE_C_V_REF(EMBED_FN_OVERLOAD_GET_SIGNATURE_QUALIFIER)
 
 #undef EMBED_FN_OVERLOAD_GET_SIGNATURE_QUALIFIER
 
+#if EMBED_CXX_VERSION >= 201703L
+# define EMBED_FN_OVERLOAD_GET_SIGNATURE_QUALIFIER(C, V, REF)                   \
+    EMBED_FN_OVERLOAD_GET_SIGNATURE_QUALIFIER_IMPL(C, V, REF, noexcept, true)
+
+    // (const / volatile / {& | &&} + noexcept) (Since C++17)
+    EMBED_FN_GENERATE_CODE_C_V_REF(EMBED_FN_OVERLOAD_GET_SIGNATURE_QUALIFIER)
+
+# undef EMBED_FN_OVERLOAD_GET_SIGNATURE_QUALIFIER
+#endif
+
+#undef EMBED_FN_OVERLOAD_GET_SIGNATURE_QUALIFIER_IMPL
+
     // qualifier_conv_safe
     /**
      * +------------------+------------------+--------+
@@ -1227,6 +1489,8 @@ namespace detail {
      * |          &       |       non-&      |   No   |
      * |      non-&&      |         &&       |   Yes  |
      * |         &&       |       non-&&     |   No   |
+     * |     noexcept     |   non-noexcept   |   Yes  |
+     * |   non-noexcept   |     noexcept     |   No   |
      * +------------------+------------------+--------+
      */
     template <typename SigFrom, typename SigTo>
@@ -1238,12 +1502,13 @@ namespace detail {
     ||(get_signature_qualifier<SigFrom>::is_volatile && !get_signature_qualifier<SigTo>::is_volatile)
     ||(get_signature_qualifier<SigFrom>::is_lref && !get_signature_qualifier<SigTo>::is_lref)
     ||(get_signature_qualifier<SigFrom>::is_rref && !get_signature_qualifier<SigTo>::is_rref)
+    ||(!get_signature_qualifier<SigFrom>::is_noexcept && get_signature_qualifier<SigTo>::is_noexcept)
         );
     };
 
 
     // is_similar_Fn_signature
-    template <typename SelfSig, typename OtherSig, std::size_t SelfSize, std::size_t OtherSize>
+    template <typename SelfSig, typename OtherSig>
     struct is_similar_Fn_signature
     {
       using SelfRet     = typename unwrap_signature<SelfSig>::ret;
@@ -1255,26 +1520,50 @@ namespace detail {
 
       static constexpr bool value = 
         is_similar_Fn<
-          SelfRet, SelfArgs, SelfArgNum, SelfSize,
-          OtherRet, OtherArgs, OtherArgNum, OtherSize
+          SelfRet, SelfArgs, SelfArgNum,
+          OtherRet, OtherArgs, OtherArgNum
         >::value 
         && qualifier_conv_safe<OtherSig, SelfSig>::value;
     };
 
     /// @e is_Fn_and_similar
+    /// @brief `Functor` is an embed::Fn with a similar signature and
+    /// any buffer size. Such an embed::Fn is never wrapped as a target.
     template <typename Signature, typename Functor>
     struct is_Fn_and_similar
     : public std::false_type { };
 
-    template <typename Signature,
-      typename OtherSignature, std::size_t BufSize>
-    struct is_Fn_and_similar<Signature, Fn<OtherSignature, BufSize>>
+    template <typename Signature, typename OtherSignature,
+      std::size_t BufSize, bool FastCall, std::size_t Align, typename Pool>
+    struct is_Fn_and_similar<Signature, Fn<OtherSignature, BufSize, FastCall, Align, Pool>>
     {
       static constexpr bool value = is_similar_Fn_signature<
-          Signature, OtherSignature, BufSize, BufSize
+          Signature, OtherSignature
         >::value;
     };
 
+    /// @e is_Fn_and_widening
+    /// @brief `Functor` is a similar embed::Fn whose target always fits
+    /// in `BufSize` and `Align`. (same or smaller buffer and alignment,
+    /// so no narrowing)
+    template <typename Signature, std::size_t BufSize, std::size_t Align,
+      typename Functor>
+    struct is_Fn_and_widening
+    : public std::false_type { };
+
+    template <typename Signature, std::size_t BufSize, std::size_t Align,
+      typename OtherSignature, std::size_t OtherSize, bool FastCall, std::size_t OtherAlign,
+      typename OtherPool>
+    struct is_Fn_and_widening<Signature, BufSize, Align,
+      Fn<OtherSignature, OtherSize, FastCall, OtherAlign, OtherPool>>
+    {
+      static constexpr bool value = is_similar_Fn_signature<
+          Signature, OtherSignature
+        >::value
+        && ( sizeof(FnBufType<OtherSize, OtherAlign>) <= sizeof(FnBufType<BufSize, Align>) )
+        && ( alignof(FnBufType<OtherSize, OtherAlign>) <= alignof(FnBufType<BufSize, Align>) );
+    };
+
     /// @e is_movable_and_non_copyable
     template <typename Functor>
     struct is_movable_and_non_copyable
@@ -1370,20 +1659,22 @@ namespace detail {
    * @brief Invoke the functor for Fn.
    */
   template <typename RetType, typename Functor, std::size_t BufSize, 
-    bool Is_volatile, bool Is_rref, typename... ArgsType>
+    bool Is_volatile, bool Is_rref, bool Is_noexcept, std::size_t Align, typename... ArgsType>
   struct FnToolBox::FnInvoker<RetType(ArgsType...), Functor,
-    BufSize, Is_volatile, Is_rref>
+    BufSize, Is_volatile, Is_rref, Is_noexcept, Align>
   {
   private:
     using FnFunctor_Qualifier = typename std::conditional<
-      Is_volatile, volatile FnFunctor<BufSize>, FnFunctor<BufSize>
+      Is_volatile, volatile FnFunctor<BufSize, Align>, FnFunctor<BufSize, Align>
     >::type;
     using Func_Qualifier = typename std::conditional<
       Is_volatile, volatile Functor, Functor
     >::type;
+    // The called object. (The stateless one of `fresh_target<Target>`)
+    using Target = typename FnTraits::is_fresh_target<Functor>::target_type;
     using FnFunctor_Cast = typename std::conditional<
-      Is_rref, typename std::remove_reference<Functor>::type&&,
-      typename std::remove_reference<Functor>::type&
+      Is_rref, typename std::remove_reference<Target>::type&&,
+      typename std::remove_reference<Target>::type&
     >::type;
 
     static EMBED_INLINE Functor*
@@ -1392,31 +1683,126 @@ namespace detail {
       const Func_Qualifier& fn = src.template M_access<Functor>();
       return const_cast<Functor*>(std::addressof(fn));
     }
-  public:
 
-    static RetType M_invoke(const FnFunctor_Qualifier& functor, ArgsType&&... args)
-    EMBED_FN_CASE_NOEXCEPT
+    static_assert(!Is_noexcept || noexcept(FnTraits::invoke_r<RetType>(
+        std::declval<FnFunctor_Cast>(), std::declval<ArgsType>()...)),
+      "embed::Fn with a noexcept Signature requires the functor to be"
+      " no-throw callable");
+
+    // Call the functor stored in `functor`.
+    static EMBED_INLINE RetType M_invoke_impl(std::false_type,
+      const FnFunctor_Qualifier& functor, FnTraits::invoke_param_t<ArgsType>... args)
+    EMBED_FN_CASE_NOEXCEPT_IF(Is_noexcept)
     {
       return FnTraits::invoke_r<RetType>(
         static_cast<FnFunctor_Cast>(*M_get_pointer(functor)),
         std::forward<ArgsType>(args)...);
     }
 
+    // Call a fresh object of the stateless functor, nothing is stored.
+    // (`Functor` is `fresh_target<Target>`)
+    static EMBED_INLINE EMBED_CXX20_CONSTEXPR RetType M_invoke_impl(std::true_type,
+      const FnFunctor_Qualifier&, FnTraits::invoke_param_t<ArgsType>... args)
+    EMBED_FN_CASE_NOEXCEPT_IF(Is_noexcept)
+    {
+      Target fn{};
+      return FnTraits::invoke_r<RetType>(
+        static_cast<FnFunctor_Cast>(fn),
+        std::forward<ArgsType>(args)...);
+    }
+
+  public:
+
+    static EMBED_CXX20_CONSTEXPR RetType M_invoke(const FnFunctor_Qualifier& functor,
+      FnTraits::invoke_param_t<ArgsType>... args)
+    EMBED_FN_CASE_NOEXCEPT_IF(Is_noexcept)
+    {
+      return M_invoke_impl(
+        std::integral_constant<bool, FnTraits::is_fresh_target<Functor>::value>{},
+        functor, std::forward<ArgsType>(args)...);
+    }
+
+  };
+
+
+  /**
+   * @c FnToolBox::FnManagerTable
+   * @brief Describe how to handle the functor of one type.
+   * @note Every entry is filled at compile time, so an embed::Fn only
+   * stores the address of the table. Invocation is one load plus one
+   * indirect call, even if `M_invoker` is not a member of embed::Fn.
+   */
+  template <typename Invoker_Type, typename FnFunctor_Qualifier, bool Is_copyable>
+  struct FnToolBox::FnManagerTable
+  {
+    using Clone_Type = void (*) (FnFunctor_Qualifier&,
+      const FnFunctor_Qualifier&) EMBED_CXX17_NOEXCEPT;
+    using Relocate_Type = void (*) (FnFunctor_Qualifier&,
+      FnFunctor_Qualifier&) EMBED_CXX17_NOEXCEPT;
+    using Destroy_Type = void (*) (FnFunctor_Qualifier&) EMBED_CXX17_NOEXCEPT;
+
+    Invoker_Type    M_invoke;   // Invoke the M_functor
+    Clone_Type      M_clone;    // Clone the M_functor (dest <- src)
+    Relocate_Type   M_relocate; // Move the M_functor (dest <- src), destroy src
+    Destroy_Type    M_destroy;  // Destroy the M_functor
+    bool            M_trivial;  // Copy / relocate / destroy as raw bytes
+  };
+
+  // The descriptor without the clone entry. (embed::MoveOnlyFn)
+  template <typename Invoker_Type, typename FnFunctor_Qualifier>
+  struct FnToolBox::FnManagerTable<Invoker_Type, FnFunctor_Qualifier, false>
+  {
+    using Relocate_Type = void (*) (FnFunctor_Qualifier&,
+      FnFunctor_Qualifier&) EMBED_CXX17_NOEXCEPT;
+    using Destroy_Type = void (*) (FnFunctor_Qualifier&) EMBED_CXX17_NOEXCEPT;
+
+    Invoker_Type    M_invoke;   // Invoke the M_functor
+    Relocate_Type   M_relocate; // Move the M_functor (dest <- src), destroy src
+    Destroy_Type    M_destroy;  // Destroy the M_functor
+    bool            M_trivial;  // Relocate / destroy as raw bytes
   };
 
 
+  /**
+   * @c FnTrivialLifecycle
+   * @brief The clone / relocate / destroy entries shared by all the trivial
+   * targets with the same buffer (size, alignment and volatile). They copy
+   * raw bytes, so one copy of the code serves every trivial target type,
+   * and a trivial target type only generates its invoker.
+   */
+  template <typename FnFunctor_Qualifier>
+  struct FnTrivialLifecycle
+  {
+    using FnFunctor_Plain = typename std::remove_cv<FnFunctor_Qualifier>::type;
+
+    /// @e M_clone
+    static void M_clone(FnFunctor_Qualifier& dest, const FnFunctor_Qualifier& src) noexcept
+    {
+      const_cast<FnFunctor_Plain&>(dest) = const_cast<const FnFunctor_Plain&>(src);
+    }
+
+    /// @e M_relocate
+    static void M_relocate(FnFunctor_Qualifier& dest, FnFunctor_Qualifier& src) noexcept
+    {
+      const_cast<FnFunctor_Plain&>(dest) = const_cast<const FnFunctor_Plain&>(src);
+    }
+
+    /// @e M_destroy
+    static void M_destroy(FnFunctor_Qualifier&) noexcept {}
+  };
+
   /**
    * @brief The Base of @c FnToolBox::FnManagerCopyable
    *                and @c FnToolBox::FnManagerMoveOnly
    */
   template <typename RetType, typename Functor, std::size_t BufSize,
-    bool Is_volatile, bool Is_rref, typename... ArgsType>
+    bool Is_volatile, bool Is_rref, bool Is_noexcept, std::size_t Align, typename... ArgsType>
   struct FnToolBox::FnManagerHelper<
-    RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref>
+    RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref, Is_noexcept, Align>
   {
   private:
     using FnFunctor_Qualifier = typename std::conditional<
-      Is_volatile, volatile FnFunctor<BufSize>, FnFunctor<BufSize>
+      Is_volatile, volatile FnFunctor<BufSize, Align>, FnFunctor<BufSize, Align>
     >::type;
     using Func_Qualifier = typename std::conditional<
       Is_volatile, volatile Functor, Functor
@@ -1428,18 +1814,19 @@ namespace detail {
 
   public:
     /// @e Invoker_Type (same as `Invoker_Type` in embed::Fn)
-    using Invoker_Type = RetType (*) (const FnFunctor_Qualifier&, ArgsType&&...) EMBED_FN_CASE_NOEXCEPT;
+    using Invoker_Type = RetType (*) (const FnFunctor_Qualifier&,
+      FnTraits::invoke_param_t<ArgsType>...) EMBED_FN_CASE_NOEXCEPT_IF(Is_noexcept);
 
   protected:
     /// @e M_create
-    /// Q: Why not use Functor, but use the `Func`?
+    /// Q: Why not use Functor, but use the `Args`?
     /// A: Because this is Perfect Forwarding, so compiler need to
-    /// deduce the type of `Func`, rather than explicitly specifying it.
-    template <typename Func>
-    static void M_create(FnFunctor_Qualifier& dest, Func&& functor) noexcept
+    /// deduce the type of `Args`, rather than explicitly specifying it.
+    template <typename... Args>
+    static void M_create(FnFunctor_Qualifier& dest, Args&&... args) noexcept
     {
       ::new (const_cast<void*>(dest.M_access()))
-        Functor(std::forward<Func>(functor));
+        Functor(std::forward<Args>(args)...);
     }
 
     /// @e M_destroy
@@ -1467,13 +1854,15 @@ namespace detail {
     }
 
     /// @e M_not_empty_function
-    template <typename Signature, std::size_t Size>
-    static bool M_not_empty_function(const Fn<Signature, Size>& f) noexcept
+    template <typename Signature, std::size_t Size, bool FastCall, std::size_t FnAlign,
+      typename Pool>
+    static bool M_not_empty_function(const Fn<Signature, Size, FastCall, FnAlign, Pool>& f) noexcept
     { return static_cast<bool>(f); }
 
-    template <typename Signature, std::size_t Size>
-    static bool M_not_empty_function(const volatile Fn<Signature, Size>& f) noexcept
-    { return f.M_manager != nullptr; }
+    template <typename Signature, std::size_t Size, bool FastCall, std::size_t FnAlign,
+      typename Pool>
+    static bool M_not_empty_function(const volatile Fn<Signature, Size, FastCall, FnAlign, Pool>& f) noexcept
+    { return f.M_manager != Fn<Signature, Size, FastCall, FnAlign, Pool>::M_empty_manager(); }
 
     template <typename T>
     static bool M_not_empty_function(T* fp) noexcept
@@ -1489,26 +1878,43 @@ namespace detail {
 
     /// @e M_init_functor
     // init functor by using M_create (perfect forward)
-    template <typename Func>
-    static void M_init_functor(FnFunctor_Qualifier& dest, Func&& functor) noexcept
+    template <typename... Args>
+    static void M_init_functor(FnFunctor_Qualifier& dest, Args&&... args) noexcept
     {
-      M_create(dest, std::forward<Func>(functor));
+      M_create(dest, std::forward<Args>(args)...);
     }
 
-#if ( EMBED_FN_NEED_FAST_CALL == false )
-
-    /// @e M_invoke
-    // This function only used when we expect FnManagerCopyable to help Fn
-    // call the functor instead of FnInvoker.
-    static RetType M_invoke(const FnFunctor_Qualifier& functor, ArgsType&&... args)
-    noexcept(FnTraits::Callable<RetType, Functor, ArgsType...>::NoThrow_v)
+    /// @e M_relocate
+    // Move-construct the functor in `dest`, then destroy it in `src`.
+    // Fused into one entry, so that relocation is one indirect call.
+    static void M_relocate(FnFunctor_Qualifier& dest, FnFunctor_Qualifier& src) noexcept
     {
-      return FnTraits::invoke_r<RetType>(
-        static_cast<FnFunctor_Cast>(*M_get_pointer(functor)),
-        std::forward<ArgsType>(args)...);
+      M_init_functor(dest, std::move( *(M_get_pointer(src)) ));
+      M_destroy(src);
     }
 
-#endif
+    /// @e M_invoker
+    using Invoker = FnInvoker<RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref, Is_noexcept, Align>;
+
+    /// @e Table_Type
+    using Table_Type = FnManagerTable<Invoker_Type, FnFunctor_Qualifier>;
+
+    /// @e Relocatable_Table_Type (no clone entry)
+    using Relocatable_Table_Type = FnManagerTable<Invoker_Type, FnFunctor_Qualifier, false>;
+
+    /// @e M_is_trivial
+    // The trivial functor (function pointer, captureless lambda, ...) can be
+    // copied, moved and destroyed as raw bytes, without calling the manager.
+    static constexpr bool M_is_trivial =
+      std::is_trivially_copyable<Functor>::value
+      && std::is_trivially_destructible<Functor>::value;
+
+    /// @e Lifecycle
+    // The relocate / destroy entries of the table. A trivial target uses the
+    // shared `FnTrivialLifecycle`, so no lifecycle code is generated per type.
+    using Lifecycle = typename std::conditional<M_is_trivial,
+      FnTrivialLifecycle<FnFunctor_Qualifier>, FnManagerHelper
+    >::type;
   };
 
 
@@ -1517,31 +1923,22 @@ namespace detail {
    * @brief Manage the functor for embed::Fn.
    */
   template <typename RetType, typename Functor, std::size_t BufSize,
-    bool Is_volatile, bool Is_rref, typename... ArgsType>
+    bool Is_volatile, bool Is_rref, bool Is_noexcept, std::size_t Align, typename... ArgsType>
   struct FnToolBox::FnManagerCopyable<
-    RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref>
+    RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref, Is_noexcept, Align>
   : public FnToolBox::FnManagerHelper<
-    RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref>
+    RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref, Is_noexcept, Align>
   {
   public:
-    constexpr static std::size_t M_max_size = sizeof(FnBufType<BufSize>);
-    constexpr static std::size_t M_max_align = alignof(FnBufType<BufSize>);
+    constexpr static std::size_t M_max_size = sizeof(FnBufType<BufSize, Align>);
+    constexpr static std::size_t M_max_align = alignof(FnBufType<BufSize, Align>);
 
     static constexpr bool noThrowExcept =
       std::is_nothrow_copy_constructible<Functor>::value
       && std::is_nothrow_destructible<Functor>::value;
 
     static constexpr bool smallAndAligned =
-      sizeof(Functor) <= M_max_size
-      && alignof(Functor) <= M_max_align
-      && (sizeof(Functor) % alignof(Functor) == 0);
-
-    /// @e Local_Storage
-    /// @brief Reserved for future use.
-    using Local_Storage = typename
-    std::integral_constant<bool,
-      noThrowExcept && smallAndAligned
-    >::type; // end Local_Storage
+      FnTraits::fits_buffer<Functor, BufSize, Align>::value;
 
     // MUST small and nothrow
     static_assert(noThrowExcept,
@@ -1549,50 +1946,37 @@ namespace detail {
       " and nothrow destructible");
     static_assert(smallAndAligned,
       "embed::Fn requires the functor to fit in `BufSize` and"
-      " have valid alignment (adjust `BufSize` if needed)");
+      " have valid alignment (adjust `BufSize` or `Align` if needed,"
+      " or keep it in an `embed::shared_block`)");
 
     using Base = FnManagerHelper<
-      RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref>;
+      RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref, Is_noexcept, Align>;
     using FnFunctor_Qualifier = typename std::conditional<
-      Is_volatile, volatile FnFunctor<BufSize>, FnFunctor<BufSize>
+      Is_volatile, volatile FnFunctor<BufSize, Align>, FnFunctor<BufSize, Align>
     >::type;
 
-    /// @e M_manager
-    // Core func to manager functor.
-    static typename Base::Invoker_Type
-    M_manager(
-      FnFunctor_Qualifier& dest, 
-      const FnFunctor_Qualifier& src, 
-      FunctorManagerOpCode op
-    ) EMBED_CXX17_NOEXCEPT {
-      typename Base::Invoker_Type invoker = nullptr;
-
-      switch (EMBED_FN_SWITCH_EXPECT(op, OP_get_invoker))
-      {
-      case OP_clone_functor:
-        Base::M_init_functor(dest,
-          *const_cast<const Functor*>(Base::M_get_pointer(src)));
-        break;
-
-      case OP_move_functor:
-        Base::M_init_functor(dest, std::move( *(Base::M_get_pointer(src)) ));
-        break;
-
-      case OP_destroy_functor:
-        Base::M_destroy(dest);
-        break;
-
-#if ( EMBED_FN_NEED_FAST_CALL == false )
-      case OP_get_invoker:
-        invoker = &Base::M_invoke;
-        break;
-#endif
+    /// @e M_clone
+    static void M_clone(FnFunctor_Qualifier& dest, const FnFunctor_Qualifier& src) noexcept
+    {
+      Base::M_init_functor(dest,
+        *const_cast<const Functor*>(Base::M_get_pointer(src)));
+    }
 
-      default: EMBED_UNREACHABLE(); /* Unreachable */ break;
-      } // end switch
+    /// @e Clone_Lifecycle
+    // The clone entry of the table. (shared by the trivial targets)
+    using Clone_Lifecycle = typename std::conditional<Base::M_is_trivial,
+      FnTrivialLifecycle<FnFunctor_Qualifier>, FnManagerCopyable
+    >::type;
 
-      return invoker;
-    }
+    /// @e M_table
+    // Core descriptor to manager functor.
+    static constexpr typename Base::Table_Type M_table = {
+      &Base::Invoker::M_invoke,
+      &Clone_Lifecycle::M_clone,
+      &Base::Lifecycle::M_relocate,
+      &Base::Lifecycle::M_destroy,
+      Base::M_is_trivial
+    };
 
   };
 
@@ -1602,31 +1986,22 @@ namespace detail {
    * @brief Manager non-copyable objects.
    */
   template <typename RetType, typename Functor, std::size_t BufSize, 
-    bool Is_volatile, bool Is_rref, typename... ArgsType>
+    bool Is_volatile, bool Is_rref, bool Is_noexcept, std::size_t Align, typename... ArgsType>
   struct FnToolBox::FnManagerMoveOnly<
-    RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref>
+    RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref, Is_noexcept, Align>
   : public FnToolBox::FnManagerHelper<
-    RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref>
+    RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref, Is_noexcept, Align>
   {
   public:
-    constexpr static std::size_t M_max_size = sizeof(FnBufType<BufSize>);
-    constexpr static std::size_t M_max_align = alignof(FnBufType<BufSize>);
+    constexpr static std::size_t M_max_size = sizeof(FnBufType<BufSize, Align>);
+    constexpr static std::size_t M_max_align = alignof(FnBufType<BufSize, Align>);
 
     static constexpr bool noThrowExcept =
       std::is_nothrow_move_constructible<Functor>::value
       && std::is_nothrow_destructible<Functor>::value;
 
     static constexpr bool smallAndAligned =
-      sizeof(Functor) <= M_max_size
-      && alignof(Functor) <= M_max_align
-      && (sizeof(Functor) % alignof(Functor) == 0);
-
-    /// @e Local_Storage
-    /// @brief Reserved for future use.
-    using Local_Storage = typename
-    std::integral_constant<bool,
-      noThrowExcept && smallAndAligned
-    >::type; // end Local_Storage
+      FnTraits::fits_buffer<Functor, BufSize, Align>::value;
 
     // MUST small and nothrow
     static_assert(noThrowExcept,
@@ -1634,72 +2009,225 @@ namespace detail {
       " and nothrow destructible");
     static_assert(smallAndAligned,
       "embed::Fn requires the functor to fit in `BufSize` and"
-      " have valid alignment (adjust `BufSize` if needed)");
+      " have valid alignment (adjust `BufSize` or `Align` if needed,"
+      " or keep it in an `embed::shared_block`)");
 
     using Base = FnManagerHelper<
-      RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref>;
+      RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref, Is_noexcept, Align>;
     using FnFunctor_Qualifier = typename std::conditional<
-      Is_volatile, volatile FnFunctor<BufSize>, FnFunctor<BufSize>
+      Is_volatile, volatile FnFunctor<BufSize, Align>, FnFunctor<BufSize, Align>
     >::type;
 
-    /// @e M_manager
-    // Core func to manager functor.
-    static typename Base::Invoker_Type
-    M_manager(
-      FnFunctor_Qualifier& dest, 
-      const FnFunctor_Qualifier& src, 
-      FunctorManagerOpCode op
-    ) EMBED_CXX17_NOEXCEPT {
-      typename Base::Invoker_Type invoker = nullptr;
-
-      switch (EMBED_FN_SWITCH_EXPECT(op, OP_get_invoker))
-      {
-      case OP_clone_functor:
-        /// @attention non-copyable object CANNOT clone!
-        bad_function_copy_handler();
-        EMBED_UNREACHABLE(); // Unreachable
-        break;
-
-      case OP_move_functor:
-        Base::M_init_functor(dest, std::move( *(Base::M_get_pointer(src)) ));
-        break;
-
-      case OP_destroy_functor:
-        Base::M_destroy(dest);
-        break;
-
-#if ( EMBED_FN_NEED_FAST_CALL == false )
-      case OP_get_invoker:
-        invoker = &Base::M_invoke;
-        break;
-#endif
+    /// @e M_clone
+    static void M_clone(FnFunctor_Qualifier&, const FnFunctor_Qualifier&) noexcept
+    {
+      /// @attention non-copyable object CANNOT clone!
+      bad_function_copy_handler();
+      EMBED_UNREACHABLE(); // Unreachable
+    }
+
+    /// @e M_table
+    // Core descriptor to manager functor.
+    // Never marked trivial: a move-only target may still be trivially
+    // copyable (deleted copy, defaulted move), and a raw byte copy would
+    // skip `M_clone`. Relocate / destroy still use the shared lifecycle.
+    static constexpr typename Base::Table_Type M_table = {
+      &Base::Invoker::M_invoke,
+      &M_clone,
+      &Base::Lifecycle::M_relocate,
+      &Base::Lifecycle::M_destroy,
+      false
+    };
+  };
+
+
+  /**
+   * @c FnToolBox::FnManagerRelocatable
+   * @brief Manage copyable or non-copyable objects for embed::MoveOnlyFn.
+   * There is no clone entry, so no copy code is generated at all.
+   */
+  template <typename RetType, typename Functor, std::size_t BufSize, 
+    bool Is_volatile, bool Is_rref, bool Is_noexcept, std::size_t Align, typename... ArgsType>
+  struct FnToolBox::FnManagerRelocatable<
+    RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref, Is_noexcept, Align>
+  : public FnToolBox::FnManagerHelper<
+    RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref, Is_noexcept, Align>
+  {
+  public:
+    constexpr static std::size_t M_max_size = sizeof(FnBufType<BufSize, Align>);
+    constexpr static std::size_t M_max_align = alignof(FnBufType<BufSize, Align>);
+
+    static constexpr bool noThrowExcept =
+      std::is_nothrow_move_constructible<Functor>::value
+      && std::is_nothrow_destructible<Functor>::value;
+
+    static constexpr bool smallAndAligned =
+      FnTraits::fits_buffer<Functor, BufSize, Align>::value;
+
+    // MUST small and nothrow
+    static_assert(noThrowExcept,
+      "embed::MoveOnlyFn requires the functor to be nothrow move-constructible"
+      " and nothrow destructible");
+    static_assert(smallAndAligned,
+      "embed::MoveOnlyFn requires the functor to fit in `BufSize` and"
+      " have valid alignment (adjust `BufSize` or `Align` if needed,"
+      " or keep it in an `embed::shared_block`)");
 
-      default: EMBED_UNREACHABLE(); /* Unreachable */ break;
-      } // end switch
+    using Base = FnManagerHelper<
+      RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref, Is_noexcept, Align>;
+
+    /// @e M_table
+    // Core descriptor to manager functor.
+    static constexpr typename Base::Relocatable_Table_Type M_table = {
+      &Base::Invoker::M_invoke,
+      &Base::Lifecycle::M_relocate,
+      &Base::Lifecycle::M_destroy,
+      Base::M_is_trivial
+    };
+  };
+
+  /**
+   * @c FnToolBox::FnEmptyManager
+   * @brief The sentinel descriptor of an empty embed::Fn.
+   * @note The target is "trivial", so the clone / relocate / destroy
+   * entries are never loaded.
+   */
+  template <typename RetType, std::size_t BufSize,
+    bool Is_volatile, bool Is_noexcept, std::size_t Align, typename... ArgsType>
+  struct FnToolBox::FnEmptyManager<RetType(ArgsType...), BufSize, Is_volatile, Is_noexcept, true, Align>
+  {
+    using FnFunctor_Qualifier = typename std::conditional<
+      Is_volatile, volatile FnFunctor<BufSize, Align>, FnFunctor<BufSize, Align>
+    >::type;
+    using Invoker_Type = RetType (*) (const FnFunctor_Qualifier&,
+      FnTraits::invoke_param_t<ArgsType>...) EMBED_FN_CASE_NOEXCEPT_IF(Is_noexcept);
+    using Table_Type = FnManagerTable<Invoker_Type, FnFunctor_Qualifier>;
 
-      return invoker;
+    /// @e M_invoke
+    // Call an empty embed::Fn.
+    [[noreturn]] static RetType M_invoke(const FnFunctor_Qualifier&,
+      FnTraits::invoke_param_t<ArgsType>...)
+    EMBED_FN_CASE_NOEXCEPT_IF(Is_noexcept)
+    {
+      throw_bad_function_call_or_abort(); /* may not throw exception */
     }
+
+    /// @e M_table
+    static constexpr Table_Type M_table = {
+      &M_invoke,
+      nullptr,
+      nullptr,
+      nullptr,
+      true
+    };
+  };
+
+  // The sentinel descriptor of an empty embed::MoveOnlyFn. (no clone entry)
+  template <typename RetType, std::size_t BufSize,
+    bool Is_volatile, bool Is_noexcept, std::size_t Align, typename... ArgsType>
+  struct FnToolBox::FnEmptyManager<RetType(ArgsType...), BufSize, Is_volatile, Is_noexcept, false, Align>
+  : public FnToolBox::FnEmptyManager<RetType(ArgsType...), BufSize, Is_volatile, Is_noexcept, true, Align>
+  {
+    using Base = FnEmptyManager<RetType(ArgsType...), BufSize, Is_volatile, Is_noexcept, true, Align>;
+    using Table_Type = FnManagerTable<
+      typename Base::Invoker_Type, typename Base::FnFunctor_Qualifier, false>;
+
+    /// @e M_table
+    static constexpr Table_Type M_table = {
+      &Base::M_invoke,
+      nullptr,
+      nullptr,
+      true
+    };
   };
 
-#define EMBED_FN_MODIFIER_HELPER_MAIN_BODY(C, V, REF)                                     \
+#if EMBED_CXX_VERSION < 201703L
+  // Before C++17, the odr-used static constexpr data member
+  // still need a definition at namespace scope.
+  template <typename RetType, std::size_t BufSize,
+    bool Is_volatile, bool Is_noexcept, std::size_t Align, typename... ArgsType>
+  constexpr typename FnToolBox::FnEmptyManager<
+    RetType(ArgsType...), BufSize, Is_volatile, Is_noexcept, true, Align>::Table_Type
+  FnToolBox::FnEmptyManager<RetType(ArgsType...), BufSize, Is_volatile, Is_noexcept, true, Align>::M_table;
+
+  template <typename RetType, std::size_t BufSize,
+    bool Is_volatile, bool Is_noexcept, std::size_t Align, typename... ArgsType>
+  constexpr typename FnToolBox::FnEmptyManager<
+    RetType(ArgsType...), BufSize, Is_volatile, Is_noexcept, false, Align>::Table_Type
+  FnToolBox::FnEmptyManager<RetType(ArgsType...), BufSize, Is_volatile, Is_noexcept, false, Align>::M_table;
+
+  template <typename RetType, typename Functor, std::size_t BufSize,
+    bool Is_volatile, bool Is_rref, bool Is_noexcept, std::size_t Align, typename... ArgsType>
+  constexpr typename FnToolBox::FnManagerCopyable<
+    RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref, Is_noexcept, Align>::Base::Table_Type
+  FnToolBox::FnManagerCopyable<
+    RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref, Is_noexcept, Align>::M_table;
+
+  template <typename RetType, typename Functor, std::size_t BufSize,
+    bool Is_volatile, bool Is_rref, bool Is_noexcept, std::size_t Align, typename... ArgsType>
+  constexpr typename FnToolBox::FnManagerMoveOnly<
+    RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref, Is_noexcept, Align>::Base::Table_Type
+  FnToolBox::FnManagerMoveOnly<
+    RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref, Is_noexcept, Align>::M_table;
+
+  template <typename RetType, typename Functor, std::size_t BufSize,
+    bool Is_volatile, bool Is_rref, bool Is_noexcept, std::size_t Align, typename... ArgsType>
+  constexpr typename FnToolBox::FnManagerRelocatable<
+    RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref, Is_noexcept, Align>::Base::Relocatable_Table_Type
+  FnToolBox::FnManagerRelocatable<
+    RetType(ArgsType...), Functor, BufSize, Is_volatile, Is_rref, Is_noexcept, Align>::M_table;
+#endif
+
+#define EMBED_FN_MODIFIER_HELPER_MAIN_BODY(C, V, REF, NOEXC_B)                            \
   template <typename Functor>                                                             \
   using Copyable = FnToolBox::FnManagerCopyable<RetType(ArgsType...),                     \
     Functor, BufSize, std::is_volatile<V int>::value,                                     \
-    std::is_rvalue_reference<int REF>::value>;                                            \
+    std::is_rvalue_reference<int REF>::value, NOEXC_B, Align>;                            \
   template <typename Functor>                                                             \
   using MoveOnly = FnToolBox::FnManagerMoveOnly<RetType(ArgsType...),                     \
     Functor, BufSize, std::is_volatile<V int>::value,                                     \
-    std::is_rvalue_reference<int REF>::value>;                                            \
+    std::is_rvalue_reference<int REF>::value, NOEXC_B, Align>;                            \
+  template <typename Functor>                                                             \
+  using Relocatable = FnToolBox::FnManagerRelocatable<RetType(ArgsType...),               \
+    Functor, BufSize, std::is_volatile<V int>::value,                                     \
+    std::is_rvalue_reference<int REF>::value, NOEXC_B, Align>;                            \
   template <typename Functor>                                                             \
   using Invoker = FnToolBox::FnInvoker<RetType(ArgsType...),                              \
     Functor, BufSize, std::is_volatile<V int>::value,                                     \
-    std::is_rvalue_reference<int REF>::value>;                                            \
+    std::is_rvalue_reference<int REF>::value, NOEXC_B, Align>;                            \
   template <typename Functor>                                                             \
   using Callable = FnToolBox::FnTraits::Callable<RetType, Functor, ArgsType...>;          \
+  using Empty = FnToolBox::FnEmptyManager<RetType(ArgsType...),                           \
+    BufSize, std::is_volatile<V int>::value, NOEXC_B, Is_copyable, Align>;                \
   using Invoker_Type = RetType (*)                                                        \
-    (const V FnFunctor<BufSize>&, ArgsType&&...) EMBED_FN_CASE_NOEXCEPT;                  \
-  using Manager_Type = Invoker_Type (*) (V FnFunctor<BufSize>&,                           \
-    const V FnFunctor<BufSize>&, FnToolBox::FunctorManagerOpCode) EMBED_CXX17_NOEXCEPT;
+    (const V FnFunctor<BufSize, Align>&,                                                  \
+    FnToolBox::FnTraits::invoke_param_t<ArgsType>...) EMBED_FN_CASE_NOEXCEPT_IF(NOEXC_B); \
+  using Manager_Type = const FnToolBox::FnManagerTable<Invoker_Type,                       \
+    V FnFunctor<BufSize, Align>, Is_copyable>*;                                           \
+  static constexpr Manager_Type M_empty_manager() noexcept                                \
+  { return Manager_Type{EMBED_FN_MODIFIER_HELPER_EMPTY_MANAGER}; }                        \
+  static constexpr Invoker_Type M_empty_invoker() noexcept                                \
+  { return Invoker_Type{EMBED_FN_MODIFIER_HELPER_EMPTY_INVOKER}; }                        \
+  EMBED_INLINE constexpr Manager_Type M_table() const noexcept                            \
+  { return M_manager; }                                                                   \
+  EMBED_INLINE constexpr bool M_has_target() const noexcept                               \
+  { return EMBED_FN_MODIFIER_HELPER_HAS_TARGET(M_manager); }                              \
+  /* Only the constant evaluation flags the target. (See `FnFunctor`) */                  \
+  EMBED_INLINE EMBED_CXX20_CONSTEXPR void M_flag_target(bool flag) noexcept               \
+  { if (EMBED_IS_CONSTANT_EVALUATED()) M_functor.M_pod_data[0] = flag; }                  \
+  EMBED_INLINE EMBED_CXX20_CONSTEXPR void M_set_empty() noexcept                          \
+  { M_set_target(M_empty_manager(), M_empty_invoker()); M_flag_target(false); }           \
+  /* To suppress the warnings of Arduino Uno, a forced type conversion is added here. */  \
+  template <typename Manager, typename Functor>                                           \
+  EMBED_INLINE void M_set_target_to() noexcept                                            \
+  {                                                                                       \
+    static_assert(                                                                        \
+      std::is_same<Manager_Type, decltype(&Manager::M_table)>::value                      \
+      && std::is_same<Invoker_Type, decltype(&Invoker<Functor>::M_invoke)>::value,        \
+      "The library ensures that the types of the two are consistent.");                   \
+    M_set_target(&Manager::M_table,                                                       \
+      reinterpret_cast<Invoker_Type>(&Invoker<Functor>::M_invoke));                       \
+  }
 
 # if defined(__clang__)
 #  pragma clang diagnostic push
@@ -1709,59 +2237,105 @@ namespace detail {
 #  pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
 # endif
 
-#if ( EMBED_FN_NEED_FAST_CALL == true )
-# define EMBED_FN_MODIFIER_HELPER_MEMVARS \
-  FnFunctor<BufSize>  M_functor{};        \
-  Manager_Type        M_manager{};        \
-  Invoker_Type        M_invoker{};
-# define EMBED_FN_MODIFIER_HELPER_INVOKE_BODY                     \
-  if EMBED_LIKELY(M_invoker)                                      \
-    return M_invoker(M_functor, std::forward<ArgsType>(args)...); \
-  else                                                            \
-    detail::throw_bad_function_call_or_abort(); /* may not throw exception */
+#if ( EMBED_FN_EMPTY_SENTINEL == true )
+# define EMBED_FN_MODIFIER_HELPER_EMPTY_MANAGER &Empty::M_table
+# define EMBED_FN_MODIFIER_HELPER_EMPTY_INVOKER &Empty::M_invoke
+# define EMBED_FN_MODIFIER_HELPER_HAS_TARGET(PTR) (PTR != M_empty_manager())
+# define EMBED_FN_MODIFIER_HELPER_LOAD_INVOKER  M_manager->M_invoke
+# define EMBED_FN_MODIFIER_HELPER_INVOKE_BODY(INVOKER, CHECK)    \
+  return INVOKER(M_functor, std::forward<ArgsType>(args)...);
 #else
-# define EMBED_FN_MODIFIER_HELPER_MEMVARS \
-  FnFunctor<BufSize>  M_functor{};        \
-  Manager_Type        M_manager{};
-# define EMBED_FN_MODIFIER_HELPER_INVOKE_BODY                               \
-  if EMBED_LIKELY(M_manager) {                                              \
-    detail::FnFunctor<BufSize> nil;                                         \
-    Invoker_Type invoker = M_manager(nil, nil, FnToolBox::OP_get_invoker);  \
-    return invoker(M_functor, std::forward<ArgsType>(args)...);             \
-  }                                                                         \
-  else                                                                      \
+# define EMBED_FN_MODIFIER_HELPER_EMPTY_MANAGER
+# define EMBED_FN_MODIFIER_HELPER_EMPTY_INVOKER
+// Comparing the address of a static with nullptr is not a constant
+// expression everywhere (e.g. `-fno-delete-null-pointer-checks`),
+// so the constant evaluation reads the flag in `M_functor` instead.
+# define EMBED_FN_MODIFIER_HELPER_HAS_TARGET(PTR)                 \
+  (EMBED_IS_CONSTANT_EVALUATED()                                  \
+    ? M_functor.M_pod_data[0] != 0 : PTR != nullptr)
+# define EMBED_FN_MODIFIER_HELPER_LOAD_INVOKER                    \
+  (M_has_target() ? M_manager->M_invoke : nullptr)
+# define EMBED_FN_MODIFIER_HELPER_INVOKE_BODY(INVOKER, CHECK)    \
+  if EMBED_LIKELY(!Is_nullable                                    \
+    || EMBED_FN_MODIFIER_HELPER_HAS_TARGET(CHECK))                \
+    return INVOKER(M_functor, std::forward<ArgsType>(args)...);   \
+  else                                                            \
     detail::throw_bad_function_call_or_abort(); /* may not throw exception */
 #endif
 
+// Fast layout: functor + manager + invoker.
+#define EMBED_FN_MODIFIER_HELPER_MEMVARS_true                                       \
+  FnFunctor<BufSize, Align> M_functor{};                                            \
+  Manager_Type              M_manager{EMBED_FN_MODIFIER_HELPER_EMPTY_MANAGER};      \
+  Invoker_Type              M_invoker{EMBED_FN_MODIFIER_HELPER_EMPTY_INVOKER};      \
+  EMBED_INLINE constexpr Invoker_Type M_get_invoker() const noexcept                \
+  { return M_invoker; }                                                             \
+  EMBED_INLINE EMBED_CXX20_CONSTEXPR                                                \
+  void M_set_target(Manager_Type manager, Invoker_Type invoker) noexcept            \
+  { M_manager = manager; M_invoker = invoker; }
+#define EMBED_FN_MODIFIER_HELPER_INVOKE_BODY_true                                   \
+  EMBED_FN_MODIFIER_HELPER_INVOKE_BODY(M_invoker, M_invoker)
+
+// Compact layout: functor + manager. (The invoker is loaded from the table)
+#define EMBED_FN_MODIFIER_HELPER_MEMVARS_false                                      \
+  FnFunctor<BufSize, Align> M_functor{};                                            \
+  Manager_Type              M_manager{EMBED_FN_MODIFIER_HELPER_EMPTY_MANAGER};      \
+  EMBED_INLINE constexpr Invoker_Type M_get_invoker() const noexcept                \
+  { return EMBED_FN_MODIFIER_HELPER_LOAD_INVOKER; }                                 \
+  EMBED_INLINE EMBED_CXX20_CONSTEXPR                                                \
+  void M_set_target(Manager_Type manager, Invoker_Type) noexcept                    \
+  { M_manager = manager; }
+#define EMBED_FN_MODIFIER_HELPER_INVOKE_BODY_false                                  \
+  EMBED_FN_MODIFIER_HELPER_INVOKE_BODY(M_manager->M_invoke, M_manager)
+
   /**
-   * @brief Help "embed::Fn" handle various different modifiers.
+   * @brief Help "embed::Fn" (and "embed::MoveOnlyFn", not copyable, and
+   * "embed::NonnullFn", not nullable) handle various different modifiers.
    */
-  template <typename Signature, std::size_t>
+  template <typename Signature, std::size_t, bool, bool = true, bool = true,
+    std::size_t = FnDefaultAlign>
   struct FnQualifierHelper
   {
     static_assert(
       !std::is_void<FnToolBox::FnTraits::void_t<Signature>>::value /* always false */,
-      "The Signature must be like `Ret(Args...) [const | volatile | & | &&]`."
+      "The Signature must be like `Ret(Args...) [const | volatile | & | &&] [noexcept]`."
       " And your signature format is incorrect.");
   };
 
-#define EMBED_FN_QUALIFIER_HELPER_CODE(C, V, REF)                         \
-  template <typename RetType, std::size_t BufSize, typename... ArgsType>  \
-  struct FnQualifierHelper<RetType(ArgsType...) C V REF, BufSize>         \
-  {                                                                       \
-    protected:                                                            \
-    EMBED_FN_MODIFIER_HELPER_MAIN_BODY(C, V, REF)                         \
-    EMBED_FN_MODIFIER_HELPER_MEMVARS                                      \
-    public:                                                               \
-    EMBED_INLINE RetType operator() (ArgsType... args) C V REF            \
-    EMBED_FN_CASE_NOEXCEPT {                                              \
-      EMBED_FN_MODIFIER_HELPER_INVOKE_BODY                                \
-    }                                                                     \
+#define EMBED_FN_QUALIFIER_HELPER_CODE_IMPL(C, V, REF, NOEXC, NOEXC_B, FAST)              \
+  template <typename RetType, std::size_t BufSize,                                    \
+    bool Is_copyable, bool Is_nullable, std::size_t Align, typename... ArgsType>      \
+  struct FnQualifierHelper<RetType(ArgsType...) C V REF NOEXC, BufSize, FAST,         \
+    Is_copyable, Is_nullable, Align>                                                  \
+  {                                                                                   \
+    protected:                                                                        \
+    EMBED_FN_MODIFIER_HELPER_MAIN_BODY(C, V, REF, NOEXC_B)                            \
+    EMBED_FN_MODIFIER_HELPER_MEMVARS_ ## FAST                                         \
+    public:                                                                           \
+    EMBED_INLINE EMBED_CXX20_CONSTEXPR                                                \
+    RetType operator() (ArgsType... args) C V REF                                     \
+    EMBED_FN_CASE_NOEXCEPT_IF(NOEXC_B) {                                              \
+      EMBED_FN_MODIFIER_HELPER_INVOKE_BODY_ ## FAST                                   \
+    }                                                                                 \
   };
 
+#define EMBED_FN_QUALIFIER_HELPER_CODE(C, V, REF)                     \
+  EMBED_FN_QUALIFIER_HELPER_CODE_IMPL(C, V, REF, , false, true)       \
+  EMBED_FN_QUALIFIER_HELPER_CODE_IMPL(C, V, REF, , false, false)
+
   // Use macro to generate code. (Overload for `FnQualifierHelper`)
   EMBED_FN_GENERATE_CODE_C_V_REF(EMBED_FN_QUALIFIER_HELPER_CODE)
 
+#if EMBED_CXX_VERSION >= 201703L
+# undef EMBED_FN_QUALIFIER_HELPER_CODE
+# define EMBED_FN_QUALIFIER_HELPER_CODE(C, V, REF)                    \
+  EMBED_FN_QUALIFIER_HELPER_CODE_IMPL(C, V, REF, noexcept, true, true) \
+  EMBED_FN_QUALIFIER_HELPER_CODE_IMPL(C, V, REF, noexcept, true, false)
+
+  // Overload for the noexcept Signature. (Since C++17)
+  EMBED_FN_GENERATE_CODE_C_V_REF(EMBED_FN_QUALIFIER_HELPER_CODE)
+#endif
+
 # if defined(__clang__)
 #  pragma clang diagnostic pop
 # elif defined(__GNUC__)
@@ -1770,49 +2344,555 @@ namespace detail {
 
 
 #undef EMBED_FN_QUALIFIER_HELPER_CODE
-#undef EMBED_FN_MODIFIER_HELPER_MEMVARS
+#undef EMBED_FN_QUALIFIER_HELPER_CODE_IMPL
+#undef EMBED_FN_MODIFIER_HELPER_MEMVARS_true
+#undef EMBED_FN_MODIFIER_HELPER_MEMVARS_false
+#undef EMBED_FN_MODIFIER_HELPER_INVOKE_BODY_true
+#undef EMBED_FN_MODIFIER_HELPER_INVOKE_BODY_false
 #undef EMBED_FN_MODIFIER_HELPER_INVOKE_BODY
+#undef EMBED_FN_MODIFIER_HELPER_EMPTY_MANAGER
+#undef EMBED_FN_MODIFIER_HELPER_EMPTY_INVOKER
+#undef EMBED_FN_MODIFIER_HELPER_HAS_TARGET
+#undef EMBED_FN_MODIFIER_HELPER_LOAD_INVOKER
 #undef EMBED_FN_MODIFIER_HELPER_MAIN_BODY
 
 } // end namespace embed::detail
 
   /**
-   * @brief   A light polymorphic wrapper for callable object.
-   * @note    Only use stack memory. NO HEAP MEMORY!
+   * @brief `embed::fixed_block_pool<BlockSize, BlockCount, Align, Tag>` is a
+   * static pool of `BlockCount` blocks, each one fits an object of
+   * `BlockSize` bytes and `Align` alignment. It never touches the heap.
+   * 
+   * `allocate` and `deallocate` are lock-free: a block is taken by setting
+   * its bit in the bitmap with compare-and-swap, and given back by clearing
+   * the bit, so they can be called from threads and interrupts.
+   * The pool records the number of blocks in use and its high-water mark.
+   * Different `Tag` types give different pools with the same geometry.
    */
-  // template <typename RetType, std::size_t BufSize, typename... ArgsType>
-  template <typename Signature, std::size_t BufSize>
-  class Fn
-  : private detail::FnToolBox
-  , public detail::FnQualifierHelper<Signature, BufSize>
+  template <std::size_t BlockSize, std::size_t BlockCount,
+    std::size_t Align = detail::FnDefaultAlign, typename Tag = void>
+  class fixed_block_pool
   {
   private:
-    using MyQualifierHelper = detail::FnQualifierHelper<Signature, BufSize>;
+    static_assert(BlockCount > 0, "embed::fixed_block_pool requires the BlockCount greater than 0");
 
-    template <typename Functor>
-    using DecayFunc_t = typename std::enable_if<
-      !std::is_same<Fn, FnTraits::remove_cvref_t<Functor> >::value,
-      typename std::decay<Functor>::type
-    >::type;
+    using Block = detail::FnFunctor<BlockSize, Align>;
 
-    template <typename Functor>
-    using MyManager = typename MyQualifierHelper::template Copyable<Functor>;
+    static constexpr std::size_t S_word_bits = sizeof(std::size_t) * 8;
+    static constexpr std::size_t S_word_count = (BlockCount - 1) / S_word_bits + 1;
 
-    template <typename Functor>
-    using MyMoveOnly = typename MyQualifierHelper::template MoveOnly<Functor>;
+    struct Storage
+    {
+      Block                     M_blocks[BlockCount];
+      std::atomic<std::size_t>  M_used[S_word_count]; // One bit per block
+      std::atomic<std::size_t>  M_in_use;
+      std::atomic<std::size_t>  M_high_water;
+    };
 
-#if ( EMBED_FN_NEED_FAST_CALL == true )
-    template <typename Functor>
-    using MyInvoker = typename MyQualifierHelper::template Invoker<Functor>;
+    // Zero-initialized (static storage), so it's ready before any constructor.
+    static Storage S_storage;
+
+    // The bits of the word `w` that stand for the blocks.
+    static constexpr std::size_t S_word_mask(std::size_t w) noexcept
+    {
+      return (w + 1 < S_word_count || BlockCount % S_word_bits == 0)
+        ? ~static_cast<std::size_t>(0)
+        : (static_cast<std::size_t>(1) << (BlockCount % S_word_bits)) - 1;
+    }
+
+    // Count one more block in use, and raise the high-water mark.
+    static void S_count_allocation() noexcept
+    {
+      std::size_t count = S_storage.M_in_use.fetch_add(1) + 1;
+      std::size_t mark = S_storage.M_high_water.load();
+      while (count > mark && !S_storage.M_high_water.compare_exchange_weak(mark, count))
+        ;
+    }
+
+  public:
+    // The size and the alignment that a block can hold.
+    static constexpr std::size_t block_size = sizeof(Block);
+    static constexpr std::size_t block_align = alignof(Block);
+
+    // The number of blocks.
+    static constexpr std::size_t capacity = BlockCount;
+
+    // Take a free block, or `nullptr` if the pool is exhausted.
+    EMBED_NODISCARD static void* allocate() noexcept
+    {
+      for (std::size_t w = 0; w < S_word_count; ++w)
+      {
+        std::size_t used = S_storage.M_used[w].load();
+        for (;;)
+        {
+          // The lowest clear bit.
+          std::size_t bit = ~used & (used + 1);
+          if ((bit & S_word_mask(w)) == 0)
+            break;
+          if (S_storage.M_used[w].compare_exchange_weak(used, used | bit))
+          {
+            std::size_t index = w * S_word_bits;
+            while (bit >>= 1)
+              ++index;
+            S_count_allocation();
+            return S_storage.M_blocks[index].M_access();
+          }
+        }
+      }
+      return nullptr;
+    }
+
+    // Give back a block taken by `allocate`.
+    static void deallocate(void* block) noexcept
+    {
+      std::size_t index = static_cast<std::size_t>(
+        static_cast<Block*>(block) - &S_storage.M_blocks[0]);
+      S_storage.M_used[index / S_word_bits].fetch_and(
+        ~(static_cast<std::size_t>(1) << (index % S_word_bits)));
+      S_storage.M_in_use.fetch_sub(1);
+    }
+
+    // The number of blocks in use.
+    EMBED_NODISCARD static std::size_t in_use() noexcept
+    { return S_storage.M_in_use.load(); }
+
+    // The largest number of blocks ever in use at the same time.
+    EMBED_NODISCARD static std::size_t high_water_mark() noexcept
+    { return S_storage.M_high_water.load(); }
+  };
+
+  template <std::size_t BlockSize, std::size_t BlockCount, std::size_t Align, typename Tag>
+  typename fixed_block_pool<BlockSize, BlockCount, Align, Tag>::Storage
+  fixed_block_pool<BlockSize, BlockCount, Align, Tag>::S_storage;
+
+namespace detail {
+
+  /// @c FnSpillInPlace
+  // Tag of the constructor of `FnSpilled` that builds the target in the pool.
+  struct FnSpillInPlace {};
+
+  /**
+   * @c FnSpilled
+   * @brief The handle of a target that lives in a block of `Pool`.
+   * embed::Fn stores the handle (one pointer) in the buffer. Move steals the
+   * block, copy takes a new block and copies the target, and destruction
+   * destroys the target and gives back the block.
+   * The copy is only provided for a copyable target.
+   */
+  template <typename Functor, typename Pool,
+    bool = std::is_copy_constructible<Functor>::value>
+  class FnSpilled
+  {
+    static_assert(sizeof(Functor) <= Pool::block_size
+      && alignof(Functor) <= Pool::block_align,
+      "embed::Fn requires the oversized functor to fit in a block"
+      " of its `Pool`");
+
+  protected:
+    Functor* M_target;
+
+    // Take a block, the pool MUST NOT be exhausted.
+    static void* M_allocate() noexcept
+    {
+      void* block = Pool::allocate();
+      if EMBED_UNLIKELY(block == nullptr)
+        pool_exhausted_handler();
+      return block;
+    }
+
+  public:
+    template <typename... Args>
+    explicit FnSpilled(FnSpillInPlace, Args&&... args) noexcept
+    : M_target(::new (M_allocate()) Functor(std::forward<Args>(args)...)) {}
+
+    FnSpilled(FnSpilled&& other) noexcept
+    : M_target(other.M_target)
+    { other.M_target = nullptr; }
+
+    ~FnSpilled()
+    {
+      if (M_target != nullptr)
+      {
+        M_target->~Functor();
+        Pool::deallocate(M_target);
+      }
+    }
+
+    // The target in the pool.
+    EMBED_INLINE Functor& M_get() const noexcept
+    { return *M_target; }
+
+    template <typename... Args>
+    EMBED_INLINE auto operator() (Args&&... args) &
+    noexcept(noexcept(std::declval<Functor&>()(std::declval<Args>()...)))
+    -> decltype(std::declval<Functor&>()(std::declval<Args>()...))
+    { return (*M_target)(std::forward<Args>(args)...); }
+
+    template <typename... Args>
+    EMBED_INLINE auto operator() (Args&&... args) &&
+    noexcept(noexcept(std::declval<Functor&&>()(std::declval<Args>()...)))
+    -> decltype(std::declval<Functor&&>()(std::declval<Args>()...))
+    { return std::move(*M_target)(std::forward<Args>(args)...); }
+  };
+
+  template <typename Functor, typename Pool>
+  class FnSpilled<Functor, Pool, true>
+  : public FnSpilled<Functor, Pool, false>
+  {
+  private:
+    using Base = FnSpilled<Functor, Pool, false>;
+
+  public:
+    template <typename... Args>
+    explicit FnSpilled(FnSpillInPlace tag, Args&&... args) noexcept
+    : Base(tag, std::forward<Args>(args)...) {}
+
+    FnSpilled(const FnSpilled& other) noexcept
+    : Base(FnSpillInPlace{}, static_cast<const Functor&>(*other.M_target)) {}
+
+    FnSpilled(FnSpilled&&) noexcept = default;
+  };
+
+  /**
+   * @c FnSpill
+   * @brief Choose how embed::Fn stores the target `Functor`: in the buffer
+   * if it fits, or else in a block of `Pool` (unless `Pool` is void).
+   */
+  template <typename Functor, std::size_t BufSize, std::size_t Align, typename Pool,
+    bool = FnToolBox::FnTraits::fits_buffer<Functor, BufSize, Align>::value
+      || std::is_void<Pool>::value>
+  struct FnSpill
+  {
+    // The object stored in the buffer.
+    using type = Functor;
+
+    template <typename Manager, typename Dest, typename... Args>
+    static EMBED_INLINE void M_init(Dest& dest, Args&&... args) noexcept
+    { Manager::M_init_functor(dest, std::forward<Args>(args)...); }
+
+    static EMBED_INLINE Functor& M_target(type& stored) noexcept
+    { return stored; }
+  };
+
+  template <typename Functor, std::size_t BufSize, std::size_t Align, typename Pool>
+  struct FnSpill<Functor, BufSize, Align, Pool, false>
+  {
+    // The object stored in the buffer.
+    using type = FnSpilled<Functor, Pool>;
+
+    template <typename Manager, typename Dest, typename... Args>
+    static EMBED_INLINE void M_init(Dest& dest, Args&&... args) noexcept
+    { Manager::M_init_functor(dest, FnSpillInPlace{}, std::forward<Args>(args)...); }
+
+    static EMBED_INLINE Functor& M_target(type& stored) noexcept
+    { return stored.M_get(); }
+  };
+
+  /// @c FnWrapperTag
+  // The base of every `FnWrapper`, so that the wrappers can be recognized.
+  struct FnWrapperTag : FnToolBox {};
+
+  /**
+   * @c FnWrapper
+   * @brief The storage and lifecycle code shared by the polymorphic wrappers.
+   * (embed::Fn, embed::MoveOnlyFn, embed::NonnullFn, embed::OverloadFn,
+   * embed::TrivialFn and embed::IndexedFn)
+   * `Derived` owns `M_functor` and the descriptor of the target, declares
+   * every `FnWrapper` as friend, and provides:
+   * 1. `M_table()`: the manager table of the target.
+   * 2. `M_set_empty()`: forget the target without destroying it.
+   * 3. `M_set_target_of(fn)`: take the descriptor (not the target) of `fn`.
+   * 4. `M_set_target_to<Manager, Functor>()`: describe the new target.
+   * 5. `Callable<Functor>` and `MyTargetManager<Functor>`.
+   * A member of `Derived` with the same name replaces the one here.
+   */
+  template <typename Derived, typename Signature = void>
+  class FnWrapper : public FnWrapperTag
+  {
+  protected:
+    EMBED_INLINE EMBED_CXX14_CONSTEXPR Derived& M_self() noexcept
+    { return static_cast<Derived&>(*this); }
+
+    EMBED_INLINE constexpr const Derived& M_self() const noexcept
+    { return static_cast<const Derived&>(*this); }
+
+    // `true` if the target can be copied / moved / destroyed as raw bytes,
+    // so that the manager need not be called. (Empty is also trivial.)
+    EMBED_INLINE EMBED_CXX14_CONSTEXPR bool M_trivial_target() const noexcept
+    {
+#if ( EMBED_FN_EMPTY_SENTINEL == true )
+      return M_self().M_table()->M_trivial;
+#else
+      return !M_self().M_has_target() || M_self().M_table()->M_trivial;
 #endif
+    }
+
+    // Requirements on the target, shared by the constructors,
+    // `emplace` and the assignment from a callable object.
+    template <typename Functor>
+    static EMBED_INLINE EMBED_CXX14_CONSTEXPR void M_check_target() noexcept
+    {
+      static_assert(Derived::template Callable<Functor>::value,
+        "embed::Fn requires the Functor is callable and the Signature match RetType");
+
+      static_assert(
+        !(FnTraits::get_signature_qualifier<Signature>::is_const
+          && FnTraits::is_class_and_has_call_operator<
+            typename FnTraits::unwrap_signature<Signature>::pure_sig,
+            Functor>::not_const_q),
+        "embed::Fn requires the signature is non-const-qualified because the"
+        " Functor::operator() is not const-qualified"
+      );
+    }
+
+    // Requirements on the target `Functor` of `emplace`, built from `Args...`.
+    template <typename Functor, typename... Args>
+    static EMBED_INLINE EMBED_CXX14_CONSTEXPR void M_check_emplace() noexcept
+    {
+      static_assert(std::is_same<Functor, typename std::decay<Functor>::type>::value,
+        "embed::Fn::emplace requires a non-reference and non-cv-qualified target type");
+
+      Derived::template M_check_target<Functor>();
+
+      static_assert(std::is_nothrow_constructible<Functor, Args...>::value,
+        "embed::Fn target must be NO-THROW constructible from the "
+        "emplace arguments");
+    }
+
+    // Construct the target `Functor` in `M_functor` from `args...`.
+    // `*this` MUST be empty. A null function pointer (or an empty embed::Fn)
+    // leaves `*this` empty and returns `false`. It owns nothing, so it
+    // needs no destruction.
+    template <typename Functor, typename... Args>
+    EMBED_INLINE bool M_construct(Args&&... args) noexcept
+    {
+      using Manager = typename Derived::template MyTargetManager<Functor>;
+
+      Manager::M_init_functor(M_self().M_functor, std::forward<Args>(args)...);
+      if (!Manager::M_not_empty_function(M_self().M_functor.template M_access<Functor>()))
+        return false;
+
+      M_self().template M_set_target_to<Manager, Functor>();
+      return true;
+    }
+
+    // Clone the target of `fn`. `*this` MUST be empty or trivial.
+    template <typename Wrapper>
+    EMBED_INLINE EMBED_CXX20_CONSTEXPR void M_clone_from(const Wrapper& fn) noexcept
+    {
+      if (fn.M_trivial_target())
+        M_self().M_functor = fn.M_functor;
+      else
+        fn.M_table()->M_clone(M_self().M_functor, fn.M_functor);
+      M_self().M_set_target_of(fn);
+    }
+
+    // Relocate the target of `fn`, and `fn` becomes empty.
+    // `*this` MUST be empty or trivial.
+    template <typename Wrapper>
+    EMBED_INLINE EMBED_CXX20_CONSTEXPR void M_relocate_from(Wrapper& fn) noexcept
+    {
+      if (fn.M_trivial_target())
+        M_self().M_functor = fn.M_functor;
+      else
+        fn.M_table()->M_relocate(M_self().M_functor, fn.M_functor);
+      M_self().M_set_target_of(fn);
+      fn.M_set_empty();
+    }
+
+    // Destroy the target, but keep the descriptor. (For the destructor)
+    EMBED_INLINE EMBED_CXX20_CONSTEXPR void M_destroy() noexcept
+    {
+      if (!M_self().M_trivial_target())
+        M_self().M_table()->M_destroy(M_self().M_functor);
+    }
+
+    // Destroy the target and become empty.
+    EMBED_INLINE EMBED_CXX20_CONSTEXPR void M_reset() noexcept
+    {
+      M_destroy();
+      M_self().M_set_empty();
+    }
+
+    // Destroy the target, then relocate the target of `fn`.
+    // At most 2 manager calls. (destroy + relocate)
+    EMBED_CXX20_CONSTEXPR Derived& M_move_assign(Derived& fn) noexcept
+    {
+      if (std::addressof(M_self()) != std::addressof(fn))
+      {
+        M_reset();
+        M_relocate_from(fn);
+      }
+      return M_self();
+    }
+
+    // Clone in place if nothing need to be destroyed (1 manager call).
+    // If `fn` is not in the buffer (so not owned by the target), destroy
+    // the target and clone in place. (destroy + clone, 2 manager calls)
+    // Otherwise copy the target to a temporary, then relocate it in.
+    // (clone + destroy + relocate, 3 manager calls)
+    EMBED_CXX20_CONSTEXPR Derived& M_copy_assign(const Derived& fn) noexcept
+    {
+      if (std::addressof(M_self()) != std::addressof(fn))
+      {
+        // A trivial target can never own `fn`, so it's safe to clone in place.
+        if (M_self().M_trivial_target())
+          M_clone_from(fn);
+        else if (!M_in_buffer(fn))
+        {
+          M_reset();
+          M_clone_from(fn);
+        }
+        else
+          M_self() = Derived(fn);
+      }
+      return M_self();
+    }
+
+    // Destroy the current target, then construct the target of
+    // type `Functor` in place from `args...`.
+    template <typename Functor, typename... Args>
+    EMBED_INLINE Derived& M_assign(Args&&... args)
+    {
+      M_reset();
+      M_self().template M_construct<Functor>(std::forward<Args>(args)...);
+      return M_self();
+    }
+
+    // `true` if `object` lies in `M_functor`, so it may be owned by the target.
+    // (The order of unrelated pointers is unspecified, which at worst
+    // takes the temporary in `M_assign_from`.)
+    template <typename Object>
+    EMBED_INLINE bool M_in_buffer(Object& object) const noexcept
+    {
+      return M_in_buffer(std::addressof(object), std::is_function<Object>());
+    }
+
+    EMBED_INLINE bool M_in_buffer(const volatile void* object, std::false_type) const noexcept
+    {
+      const volatile char* begin =
+        reinterpret_cast<const volatile char*>(std::addressof(M_self().M_functor));
+      const volatile char* address = static_cast<const volatile char*>(object);
+      return !(address < begin) && address < begin + sizeof(M_self().M_functor);
+    }
+
+    // A function is never in the buffer.
+    template <typename FuncPtr>
+    EMBED_INLINE constexpr bool M_in_buffer(FuncPtr, std::true_type) const noexcept
+    {
+      return false;
+    }
+
+    // Make a copy of `func` (of type `Functor`) the target.
+    // `func` may be owned by the current target, so it is built in place
+    // (at most 1 manager call) only if the current target is trivial and
+    // `func` is not in the buffer. Otherwise it is built in a temporary,
+    // which is relocated in after the current target is destroyed.
+    template <typename Functor, typename Func>
+    EMBED_INLINE Derived& M_assign_from(Func&& func)
+    {
+      if (M_self().M_trivial_target() && !M_in_buffer(func))
+        return M_assign<Functor>(std::forward<Func>(func));
+      return M_self() = Derived(std::forward<Func>(func));
+    }
+
+  public:
+    // Swap the targets. (At most 3 manager calls)
+    void swap(Derived& fn) noexcept
+    {
+      if (std::addressof(M_self()) == std::addressof(fn))
+        return;
+
+      Derived tmp(std::move(fn));
+      fn.M_relocate_from(M_self());
+      M_relocate_from(tmp);
+    }
+
+    // Swap the targets of two wrappers. (Found by ADL)
+    friend EMBED_INLINE void swap(Derived& fn1, Derived& fn2) noexcept
+    { fn1.swap(fn2); }
+
+    // `true` if the wrapper has no target, `false` otherwise. (noexcept)
+    friend EMBED_INLINE constexpr bool operator==(const Derived& fn, std::nullptr_t) noexcept
+    { return fn.is_empty(); }
+
+    // `true` if the wrapper has no target, `false` otherwise. (noexcept)
+    friend EMBED_INLINE constexpr bool operator==(std::nullptr_t, const Derived& fn) noexcept
+    { return fn.is_empty(); }
+
+    // `true` if the wrapper does have target, `false` otherwise. (noexcept)
+    friend EMBED_INLINE constexpr bool operator!=(const Derived& fn, std::nullptr_t) noexcept
+    { return !fn.is_empty(); }
+
+    // `true` if the wrapper does have target, `false` otherwise. (noexcept)
+    friend EMBED_INLINE constexpr bool operator!=(std::nullptr_t, const Derived& fn) noexcept
+    { return !fn.is_empty(); }
+  };
+
+} // end namespace embed::detail
+
+  /**
+   * @brief   A light polymorphic wrapper for callable object.
+   * @note    Only use stack memory. NO HEAP MEMORY!
+   */
+  // template <typename RetType, std::size_t BufSize, typename... ArgsType>
+  template <typename Signature, std::size_t BufSize, bool FastCall, std::size_t Align,
+    typename Pool>
+  class Fn
+  : private detail::FnWrapper<Fn<Signature, BufSize, FastCall, Align, Pool>, Signature>
+  , public detail::FnQualifierHelper<Signature, BufSize, FastCall, true, true, Align>
+  {
+  private:
+    using MyWrapper = detail::FnWrapper<Fn, Signature>;
+
+    using MyQualifierHelper = detail::FnQualifierHelper<Signature, BufSize, FastCall,
+      true, true, Align>;
+
+    using FnTraits = detail::FnToolBox::FnTraits;
+
+    // embed::TrivialFn with the same layout converts by itself,
+    // it's not wrapped as a target.
+    template <typename Functor>
+    using DecayFunc_t = typename std::enable_if<
+      !std::is_same<Fn, FnTraits::remove_cvref_t<Functor> >::value
+      && !std::is_same<TrivialFn<Signature, BufSize, FastCall>,
+        FnTraits::remove_cvref_t<Functor> >::value,
+      typename std::decay<Functor>::type
+    >::type;
+
+    template <typename Functor>
+    using MyManager = typename MyQualifierHelper::template Copyable<Functor>;
+
+    template <typename Functor>
+    using MyMoveOnly = typename MyQualifierHelper::template MoveOnly<Functor>;
+
+    template <typename Functor>
+    using MyInvoker = typename MyQualifierHelper::template Invoker<Functor>;
 
     using Invoker_Type = typename MyQualifierHelper::Invoker_Type;
 
     using Manager_Type = typename MyQualifierHelper::Manager_Type;
 
+    // The manager of the target `Functor`. (copyable or move-only)
+    template <typename Functor>
+    using MyTargetManager = typename std::conditional<
+      std::is_copy_constructible<Functor>::value,
+      MyManager<Functor>, MyMoveOnly<Functor>
+    >::type;
+
     template <typename Functor>
     using Callable = typename MyQualifierHelper::template Callable<Functor>;
 
+    // The storage and lifecycle code shared by the wrappers.
+    template <typename Derived, typename Sig>
+    friend class detail::FnWrapper;
+
+    using MyWrapper::M_trivial_target;
+    using MyWrapper::M_clone_from;
+    using MyWrapper::M_relocate_from;
+    using MyWrapper::M_destroy;
+    using MyWrapper::M_reset;
+
     // The `M_functor` store the callable object.
     using MyQualifierHelper::M_functor;
 
@@ -1820,22 +2900,108 @@ namespace detail {
     // and even describes how to invoke `M_functor` when not using `M_invoker`.
     using MyQualifierHelper::M_manager;
 
-#if ( EMBED_FN_NEED_FAST_CALL == true )
-    // invoker for the functor (func pointer)
-    /// If @b EMBED_FN_NEED_FAST_CALL is not true, `M_manager` 
-    /// will help Fn invoke functor instead of `M_invoker`.
-    using MyQualifierHelper::M_invoker;
-#endif
+    // Read / write the invoker for the functor (func pointer).
+    /// In the fast layout, `M_invoker` is stored next to `M_manager`.
+    /// In the compact layout, `M_manager` will help Fn invoke functor.
+    using MyQualifierHelper::M_get_invoker;
+    using MyQualifierHelper::M_set_target;
+    using MyQualifierHelper::M_set_empty;
+    using MyQualifierHelper::M_empty_manager;
+    using MyQualifierHelper::M_has_target;
+    using MyQualifierHelper::M_flag_target;
 
     // ArgsPackage, RetType, and ArgsNum
     using ArgsPackage   = typename          FnTraits::unwrap_signature<Signature>::args;
     using RetType       = typename          FnTraits::unwrap_signature<Signature>::ret;
     static constexpr std::size_t ArgsNum =  FnTraits::unwrap_signature<Signature>::arg_num;
 
-    // Regard all Fn<Signature, BufSize> as friend class.
-    template <typename Sig, std::size_t BSize>
+    // Regard all Fn<Signature, BufSize, FastCall, Align, Pool> as friend class.
+    template <typename Sig, std::size_t BSize, bool Fast, std::size_t BAlign, typename BPool>
     friend class Fn;
 
+    // embed::NonnullFn takes the target of embed::Fn.
+    template <typename Sig, std::size_t BSize, bool Fast>
+    friend class NonnullFn;
+
+    // embed::TrivialFn converts into embed::Fn.
+    template <typename Sig, std::size_t BSize, bool Fast>
+    friend class TrivialFn;
+
+    // embed::function_table takes the target of embed::Fn.
+    template <typename Sig, std::size_t BSize, std::size_t Cap>
+    friend class function_table;
+
+    // The manager helper checks if a (volatile) embed::Fn target is empty.
+    template <typename Sig, typename Functor, std::size_t BSize,
+      bool Is_volatile, bool Is_rref, bool Is_noexcept, std::size_t BAlign>
+    friend struct detail::FnToolBox::FnManagerHelper;
+
+    // Take the descriptor (not the target) of `fn`.
+    template <typename Wrapper>
+    EMBED_INLINE EMBED_CXX20_CONSTEXPR void M_set_target_of(const Wrapper& fn) noexcept
+    {
+      M_set_target(fn.M_manager, fn.M_get_invoker());
+    }
+
+    // Relocate the target managed by `manager` from `src` to `dest`.
+    // (move-construct in `dest`, then destroy in `src`)
+    template <typename Manager, typename Functor>
+    static EMBED_INLINE EMBED_CXX20_CONSTEXPR void
+    M_relocate(Manager manager, Functor& dest, Functor& src) noexcept
+    {
+#if ( EMBED_FN_EMPTY_SENTINEL == true )
+      if (manager->M_trivial)
+#else
+      if ((manager == nullptr) || manager->M_trivial)
+#endif
+        dest = src;
+      else
+        manager->M_relocate(dest, src);
+    }
+
+    // Construct the target `Functor` in `M_functor` from `args...`.
+    // A null function pointer (or an empty embed::Fn) leaves `*this` empty,
+    // and needs no destruction. `*this` MUST be empty.
+    // In constant evaluation, a stateless target built trivially is not
+    // stored at all, which keeps the construction usable there: its manager
+    // and invoker are the ones of `fresh_target<Functor>`. (Since C++20)
+    // At runtime it is stored and called as any other target, so `emplace`
+    // returns the object that is called.
+    // An oversized target is placed in a block of `Pool`, and only
+    // its handle is stored in `M_functor`. (See `detail::FnSpill`)
+    template <typename Functor, typename... Args>
+    EMBED_INLINE EMBED_CXX20_CONSTEXPR void M_construct(Args&&... args) noexcept
+    {
+      using Spill = detail::FnSpill<Functor, BufSize, Align, Pool>;
+      using Stored = typename Spill::type;
+      using Manager = Fn::MyTargetManager<Stored>;
+
+      constexpr bool Is_fresh = FnTraits::is_stateless_target<Functor>::value
+        && std::is_trivially_constructible<Functor, Args...>::value;
+
+      if (Is_fresh && EMBED_IS_CONSTANT_EVALUATED())
+      {
+        // (Only instantiated for a stateless `Functor`)
+        using Fresh = typename std::conditional<Is_fresh,
+          FnTraits::fresh_target<Functor>, Stored>::type;
+        M_set_target(&Fn::MyTargetManager<Fresh>::M_table, &Fn::MyInvoker<Fresh>::M_invoke);
+        M_flag_target(true);
+        return;
+      }
+
+      Spill::template M_init<Manager>(M_functor, std::forward<Args>(args)...);
+      Stored& stored = M_functor.template M_access<Stored>();
+      if (!Manager::M_not_empty_function(Spill::M_target(stored)))
+      {
+        // Give back the block of an empty spilled target.
+        if (!std::is_same<Stored, Functor>::value)
+          stored.~Stored();
+        return;
+      }
+
+      this->template M_set_target_to<Manager, Stored>();
+    }
+
   public:
     // See https://en.cppreference.com/w/cpp/utility/functional/function.html
     // Get the return type.
@@ -1844,8 +3010,11 @@ namespace detail {
     // The `BufSize` of this embed::Fn object.
     static constexpr std::size_t buffer_size = BufSize;
 
-    // `true` if fast-call mode is enabled.
-    static constexpr bool is_fast_mode = static_cast<bool>(EMBED_FN_NEED_FAST_CALL);
+    // The alignment of the buffer of this embed::Fn object.
+    static constexpr std::size_t buffer_align = alignof(detail::FnBufType<BufSize, Align>);
+
+    // `true` if this embed::Fn uses the fast layout (stores the invoker).
+    static constexpr bool is_fast_mode = FastCall;
 
   public:
 
@@ -1869,10 +3038,9 @@ namespace detail {
      * and unused `embed::Fn` instances and completely eliminating
      * the destructors and stack space of the objects.
      */
-    EMBED_INLINE ~Fn() noexcept
+    EMBED_INLINE EMBED_CXX20_CONSTEXPR ~Fn() noexcept
     {
-      if (M_manager)
-        (void)M_manager(M_functor, M_functor, OP_destroy_functor);
+      M_destroy();
     }
 
     // Create an empty function wrapper.
@@ -1881,57 +3049,69 @@ namespace detail {
 
     // Create an empty function wrapper.
     /// @deprecated Creating an empty embed::Fn instance is risky.
-    EMBED_INLINE Fn(std::nullptr_t) noexcept {}
-
-#if ( EMBED_FN_NEED_FAST_CALL == true )
+    EMBED_INLINE EMBED_CXX20_CONSTEXPR Fn(std::nullptr_t) noexcept {}
 
     // Copy constructor for embed::Fn.
     // Use `placement new` to create new functor,
     // which will call functor's copy-constructor.
-    Fn(const Fn& fn) noexcept
+    EMBED_CXX20_CONSTEXPR Fn(const Fn& fn) noexcept
     {
-      if (static_cast<bool>(fn))
-      {
-        fn.M_manager(M_functor, fn.M_functor, OP_clone_functor);
-        M_manager = fn.M_manager;
-        M_invoker = fn.M_invoker;
-      }
+      M_clone_from(fn);
     }
 
     // Move constructor for embed::Fn.
     // Use `placement new` to create new functor,
     // which will call functor's move-constructor.
-    Fn(Fn&& fn) noexcept
+    EMBED_CXX20_CONSTEXPR Fn(Fn&& fn) noexcept
     {
-      if (static_cast<bool>(fn))
-      {
-        fn.M_manager(M_functor, fn.M_functor, OP_move_functor);
-        M_manager = fn.M_manager;
-        M_invoker = fn.M_invoker;
-        fn.M_manager = nullptr;
-        fn.M_invoker = nullptr;
-      }
+      M_relocate_from(fn);
     }
 
     // Construct Fn<Sig_A> with Fn<Sig_B>
     // restrictions: `Sig_B.ret` can convert to `Sig_A.ret`
     // `Sig_A.args` are same with `Sig_B.args`.
-    template <typename OtherSignature, std::size_t OtherSize>
+    // The BufSize of Fn<Sig_B> is not larger (widening only), the target
+    // is cloned into our buffer and keeps its manager, not nested.
+    // Fast and compact layouts convert to each other, which only
+    // drops the invoker or loads it from the manager table.
+    template <typename OtherSignature, std::size_t OtherSize, bool OtherFast,
+      std::size_t OtherAlign, typename OtherPool>
     Fn(
-      const Fn<OtherSignature, OtherSize>& fn,
-      typename std::enable_if<FnTraits::is_Fn_and_similar<
-        Signature, Fn<OtherSignature, OtherSize>
+      const Fn<OtherSignature, OtherSize, OtherFast, OtherAlign, OtherPool>& fn,
+      typename std::enable_if<FnTraits::is_Fn_and_widening<
+        Signature, BufSize, Align, Fn<OtherSignature, OtherSize, OtherFast, OtherAlign, OtherPool>
       >::value, bool>::type = true
     ) noexcept {
-      if (static_cast<bool>(fn))
-      {
-        fn.M_manager(
-          *reinterpret_cast<detail::FnFunctor<OtherSize>*>(&M_functor),
-          fn.M_functor, OP_clone_functor
-        );
-        M_manager = reinterpret_cast<Manager_Type>(fn.M_manager);
-        M_invoker = reinterpret_cast<Invoker_Type>(fn.M_invoker);
-      }
+      if (fn.is_empty())
+        return; // Keep our own empty state.
+      detail::FnFunctor<OtherSize, OtherAlign>& dest =
+        *reinterpret_cast<detail::FnFunctor<OtherSize, OtherAlign>*>(&M_functor);
+      if (fn.M_trivial_target())
+        dest = fn.M_functor;
+      else
+        fn.M_manager->M_clone(dest, fn.M_functor);
+      Manager_Type manager = reinterpret_cast<Manager_Type>(fn.M_manager);
+      M_set_target(manager, manager->M_invoke);
+    }
+
+    // Move construct Fn<Sig_A> with Fn<Sig_B>, relocate the target.
+    // restrictions: same as the copy version.
+    template <typename OtherSignature, std::size_t OtherSize, bool OtherFast,
+      std::size_t OtherAlign, typename OtherPool>
+    Fn(
+      Fn<OtherSignature, OtherSize, OtherFast, OtherAlign, OtherPool>&& fn,
+      typename std::enable_if<FnTraits::is_Fn_and_widening<
+        Signature, BufSize, Align, Fn<OtherSignature, OtherSize, OtherFast, OtherAlign, OtherPool>
+      >::value, bool>::type = true
+    ) noexcept {
+      if (fn.is_empty())
+        return; // Keep our own empty state.
+      M_relocate(fn.M_manager,
+        *reinterpret_cast<detail::FnFunctor<OtherSize, OtherAlign>*>(&M_functor),
+        fn.M_functor);
+      Manager_Type manager = reinterpret_cast<Manager_Type>(fn.M_manager);
+      M_set_target(manager, manager->M_invoke);
+      fn.M_set_empty();
     }
 
     /**
@@ -1952,10 +3132,9 @@ namespace detail {
         Signature, FnTraits::remove_cvref_t<Functor>
       >::value>::type,
       typename = FnTraits::disableIf_movable_and_non_copyable_and_nref_t<Functor> >
-    Fn(Functor&& func) noexcept
+    EMBED_CXX20_CONSTEXPR Fn(Functor&& func) noexcept
     {
-      static_assert(Fn::Callable<Functor>::value,
-        "embed::Fn requires the Functor is callable and the Signature match RetType");
+      MyWrapper::template M_check_target<Functor>();
 
       static_assert(std::is_copy_constructible<DecayFunctor>::value,
         "embed::Fn target must be copy-constructible");
@@ -1964,28 +3143,7 @@ namespace detail {
         "embed::Fn target must be NO-THROW constructible from the "
         "constructor argument");
 
-      static_assert(
-        !(FnTraits::get_signature_qualifier<Signature>::is_const 
-          && FnTraits::is_class_and_has_call_operator<
-            typename FnTraits::unwrap_signature<Signature>::pure_sig,
-            Functor>::not_const_q),
-        "embed::Fn requires the signature is non-const-qualified because the"
-        " Functor::operator() is not const-qualified"
-      );
-
-      if (Fn::MyManager<DecayFunctor>::M_not_empty_function(func))
-      {
-        Fn::MyManager<DecayFunctor>::M_init_functor(M_functor, std::forward<Functor>(func));
-
-        // To suppress the warnings of Arduino Uno, a forced type conversion is added here.
-        static_assert(
-          std::is_same<Manager_Type, decltype(&Fn::MyManager<DecayFunctor>::M_manager)>::value
-          && std::is_same<Invoker_Type, decltype(&Fn::MyInvoker<DecayFunctor>::M_invoke)>::value,
-          "The library ensures that the types of the two are consistent."
-        );
-        M_manager = reinterpret_cast<Manager_Type>(&Fn::MyManager<DecayFunctor>::M_manager);
-        M_invoker = reinterpret_cast<Invoker_Type>(&Fn::MyInvoker<DecayFunctor>::M_invoke);
-      }
+      M_construct<DecayFunctor>(std::forward<Functor>(func));
     }
 
 # if !defined(EMBED_NO_NONCOPYABLE_FUNCTOR)
@@ -2003,364 +3161,2624 @@ namespace detail {
       typename = typename std::enable_if<!std::is_reference<Functor>::value>::type >
     Fn(Functor&& func)
     {
-      static_assert(Fn::Callable<Functor>::value,
-        "embed::Fn requires the Functor is callable and the Signature match RetType");
-
-      static_assert(
-        !(FnTraits::get_signature_qualifier<Signature>::is_const 
-          && FnTraits::is_class_and_has_call_operator<
-            typename FnTraits::unwrap_signature<Signature>::pure_sig,
-            Functor>::not_const_q),
-        "embed::Fn requires the signature is non-const-qualified because the"
-        " Functor::operator() is not const-qualified"
-      );
-
-      if (Fn::MyMoveOnly<DecayFunctor>::M_not_empty_function(func))
-      {
-        Fn::MyMoveOnly<DecayFunctor>::M_init_functor(M_functor, std::move(func));
+      MyWrapper::template M_check_target<Functor>();
 
-        // To suppress the warnings of Arduino Uno, a forced type conversion is added here.
-        static_assert(
-          std::is_same<Manager_Type, decltype(&Fn::MyMoveOnly<DecayFunctor>::M_manager)>::value
-          && std::is_same<Invoker_Type, decltype(&Fn::MyInvoker<DecayFunctor>::M_invoke)>::value,
-          "The library ensures that the types of the two are consistent."
-        );
-        M_manager = reinterpret_cast<Manager_Type>(&Fn::MyMoveOnly<DecayFunctor>::M_manager);
-        M_invoker = reinterpret_cast<Invoker_Type>(&Fn::MyInvoker<DecayFunctor>::M_invoke);
-      }
+      M_construct<DecayFunctor>(std::move(func));
     }
 # endif // !defined(EMBED_NO_NONCOPYABLE_FUNCTOR)
 
-    // Swap Fn but unknown the real type of `Functor`.
-    // But only M_manager remember the `Functor`.
-    void swap(Fn& fn) noexcept
+    /**
+     * @brief Construct the target of type `Functor` in place from `args...`,
+     * without building a temporary callable object.
+     * @example embed::function<int(int)> fn(embed::in_place_type_t<Adder>{}, 1);
+     */
+    template <typename Functor, typename... Args>
+    explicit Fn(in_place_type_t<Functor>, Args&&... args) noexcept
     {
-      detail::FnFunctor<BufSize> tmpFunc{};
-      if (M_manager)
-      {
-        M_manager(tmpFunc, M_functor, OP_move_functor);
-        M_manager(M_functor, M_functor, OP_destroy_functor);
-      }
-      if (static_cast<bool>(fn))
-      {
-        fn.M_manager(M_functor, fn.M_functor, OP_move_functor);
-        fn.M_manager(fn.M_functor, fn.M_functor, OP_destroy_functor);
-      }
-      if (M_manager)
-      {
-        M_manager(fn.M_functor, tmpFunc, OP_move_functor);
-        M_manager(tmpFunc, tmpFunc, OP_destroy_functor);
+      emplace<Functor>(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroy the current target, then construct the target of
+     * type `Functor` in place from `args...`. (at most 1 manager call)
+     * @return The reference to the new target.
+     * @note `args...` MUST NOT refer to the current target.
+     */
+    template <typename Functor, typename... Args>
+    Functor& emplace(Args&&... args) noexcept
+    {
+      MyWrapper::template M_check_emplace<Functor, Args...>();
+
+# if defined(EMBED_NO_NONCOPYABLE_FUNCTOR)
+      static_assert(std::is_copy_constructible<Functor>::value,
+        "embed::Fn target must be copy-constructible");
+# endif
+
+      this->template M_assign<Functor>(std::forward<Args>(args)...);
+      using Spill = detail::FnSpill<Functor, BufSize, Align, Pool>;
+      return Spill::M_target(M_functor.template M_access<typename Spill::type>());
+    }
+
+    // Swap Fn but unknown the real type of `Functor`.
+    // But only M_manager remember the `Functor`.
+    // At most 3 manager calls. (None for the trivial targets.)
+    using MyWrapper::swap;
+
+    /// @brief Overload the function specifically for the case where nullptr is
+    /// passed as a parameter, in order to improve the program's running efficiency. 
+    /// (Using the `swap` method would be much slower.)
+    EMBED_INLINE EMBED_CXX20_CONSTEXPR Fn& operator=(std::nullptr_t) noexcept
+    {
+      M_reset();
+      return *this;
+    }
+
+    /// @brief Overload the move assign to enhance the performance.
+    // At most 2 manager calls. (destroy + relocate)
+    EMBED_CXX20_CONSTEXPR Fn& operator=(Fn&& fn) noexcept
+    {
+      return this->M_move_assign(fn);
+    }
+
+
+    /// @brief Clone in place if nothing need to be destroyed (1 manager call).
+    /// Otherwise copy the target to a temporary, then relocate it in.
+    /// (clone + destroy + relocate, 3 manager calls)
+    EMBED_INLINE EMBED_CXX20_CONSTEXPR Fn& operator=(const Fn& fn) noexcept
+    {
+      return this->M_copy_assign(fn);
+    }
+
+    /// @brief Same as the copy assignment.
+    template <typename OtherSignature, std::size_t OtherSize, bool OtherFast,
+      std::size_t OtherAlign, typename OtherPool,
+      typename = typename std::enable_if<FnTraits::is_Fn_and_widening<
+        Signature, BufSize, Align, Fn<OtherSignature, OtherSize, OtherFast, OtherAlign, OtherPool>
+      >::value>::type>
+    EMBED_INLINE Fn& operator=(const Fn<OtherSignature, OtherSize, OtherFast, OtherAlign, OtherPool>& fn) noexcept 
+    {
+      *this = Fn(fn);
+      return *this;
+    }
+
+    /// @brief Relocate the target of similar embed::Fn instance.
+    template <typename OtherSignature, std::size_t OtherSize, bool OtherFast,
+      std::size_t OtherAlign, typename OtherPool,
+      typename = typename std::enable_if<FnTraits::is_Fn_and_widening<
+        Signature, BufSize, Align, Fn<OtherSignature, OtherSize, OtherFast, OtherAlign, OtherPool>
+      >::value>::type>
+    EMBED_INLINE Fn& operator=(Fn<OtherSignature, OtherSize, OtherFast, OtherAlign, OtherPool>&& fn) noexcept 
+    {
+      *this = Fn(std::move(fn));
+      return *this;
+    }
+
+    /// @brief Replace the target by a copy of `func`, which may be owned by
+    /// the current target. Built in place (at most 1 manager call) if the
+    /// current target is trivial, or else built in a temporary and relocated in.
+    template <typename Functor,
+      typename DecayFunc = Fn::DecayFunc_t<Functor>,
+      typename = typename std::enable_if<!FnTraits::is_Fn_and_similar<
+        Signature, FnTraits::remove_cvref_t<Functor>
+      >::value>::type>
+    EMBED_INLINE Fn& operator=(Functor&& func) noexcept
+    {
+      MyWrapper::template M_check_target<Functor>();
+
+# if defined(EMBED_NO_NONCOPYABLE_FUNCTOR)
+      static_assert(std::is_copy_constructible<DecayFunc>::value,
+        "embed::Fn target must be copy-constructible");
+# else
+      static_assert(std::is_copy_constructible<DecayFunc>::value
+        || !std::is_reference<Functor>::value,
+        "embed::Fn target must be copy-constructible");
+# endif
+
+      static_assert(std::is_nothrow_constructible<DecayFunc, Functor>::value
+        || !std::is_copy_constructible<DecayFunc>::value,
+        "embed::Fn target must be NO-THROW constructible from the "
+        "assignment argument");
+
+      return this->template M_assign_from<DecayFunc>(std::forward<Functor>(func));
+    }
+
+    // check if the embed::Fn is empty.
+    EMBED_INLINE constexpr bool is_empty() const noexcept
+    {
+      return !M_has_target();
+    }
+
+    // `true` if the embed::Fn is not empty.
+    EMBED_INLINE constexpr explicit operator bool() const noexcept
+    {
+      return !is_empty();
+    }
+
+
+  }; // end Fn
+
+
+  /**
+   * @brief   A move-only polymorphic wrapper for callable object.
+   * The copy operations are deleted, and the manager of the target has
+   * no clone entry, so copy misuse is a compile error and no copy code
+   * is generated. Both copyable and non-copyable targets are accepted.
+   * @note    Only use stack memory. NO HEAP MEMORY!
+   */
+  template <typename Signature, std::size_t BufSize, bool FastCall>
+  class MoveOnlyFn
+  : private detail::FnWrapper<MoveOnlyFn<Signature, BufSize, FastCall>, Signature>
+  , public detail::FnQualifierHelper<Signature, BufSize, FastCall, false>
+  {
+  private:
+    using MyWrapper = detail::FnWrapper<MoveOnlyFn, Signature>;
+
+    using MyQualifierHelper = detail::FnQualifierHelper<Signature, BufSize, FastCall, false>;
+
+    using FnTraits = detail::FnToolBox::FnTraits;
+
+    template <typename Functor>
+    using DecayFunc_t = typename std::enable_if<
+      !std::is_same<MoveOnlyFn, FnTraits::remove_cvref_t<Functor> >::value,
+      typename std::decay<Functor>::type
+    >::type;
+
+    template <typename Functor>
+    using MyTargetManager = typename MyQualifierHelper::template Relocatable<Functor>;
+
+    template <typename Functor>
+    using Callable = typename MyQualifierHelper::template Callable<Functor>;
+
+    // The storage and lifecycle code shared by the wrappers.
+    template <typename Derived, typename Sig>
+    friend class detail::FnWrapper;
+
+    using MyWrapper::M_relocate_from;
+    using MyWrapper::M_destroy;
+    using MyWrapper::M_reset;
+
+    using MyQualifierHelper::M_functor;
+    using MyQualifierHelper::M_manager;
+    using MyQualifierHelper::M_get_invoker;
+    using MyQualifierHelper::M_set_target;
+    using MyQualifierHelper::M_set_empty;
+    using MyQualifierHelper::M_empty_manager;
+    using MyQualifierHelper::M_has_target;
+
+    using RetType = typename FnTraits::unwrap_signature<Signature>::ret;
+
+    // Take the descriptor (not the target) of `fn`.
+    EMBED_INLINE void M_set_target_of(const MoveOnlyFn& fn) noexcept
+    {
+      M_set_target(fn.M_manager, fn.M_get_invoker());
+    }
+
+  public:
+    // Get the return type.
+    using result_type = RetType;
+
+    // The `BufSize` of this embed::MoveOnlyFn object.
+    static constexpr std::size_t buffer_size = BufSize;
+
+    // `true` if this embed::MoveOnlyFn uses the fast layout (stores the invoker).
+    static constexpr bool is_fast_mode = FastCall;
+
+  public:
+    // Destroy the functor, call functor's destructor.
+    EMBED_INLINE ~MoveOnlyFn() noexcept
+    {
+      M_destroy();
+    }
+
+    // Create an empty function wrapper.
+    EMBED_INLINE MoveOnlyFn() noexcept = default;
+
+    // Create an empty function wrapper.
+    EMBED_INLINE MoveOnlyFn(std::nullptr_t) noexcept {}
+
+    // Not copyable.
+    MoveOnlyFn(const MoveOnlyFn&) = delete;
+    MoveOnlyFn& operator=(const MoveOnlyFn&) = delete;
+
+    // Relocate the target of `fn`, and `fn` becomes empty.
+    MoveOnlyFn(MoveOnlyFn&& fn) noexcept
+    {
+      M_relocate_from(fn);
+    }
+
+    /**
+     * @brief Builds a MoveOnlyFn that targets the incoming function object.
+     * REQUIRE:
+     * 1. `decltype(func)` must be Callable.
+     * 2. `std::decay<decltype(func)>::type` must be nothrow constructible from
+     * the type `decltype(func)` object.
+     */
+    template <typename Functor,
+      typename DecayFunctor = MoveOnlyFn::DecayFunc_t<Functor> >
+    MoveOnlyFn(Functor&& func) noexcept
+    {
+      MyWrapper::template M_check_target<Functor>();
+
+      static_assert(std::is_nothrow_constructible<DecayFunctor, Functor>::value,
+        "embed::MoveOnlyFn target must be NO-THROW constructible from the "
+        "constructor argument");
+
+      this->template M_construct<DecayFunctor>(std::forward<Functor>(func));
+    }
+
+    // Construct the target of type `Functor` in place from `args...`.
+    template <typename Functor, typename... Args>
+    explicit MoveOnlyFn(in_place_type_t<Functor>, Args&&... args) noexcept
+    {
+      emplace<Functor>(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroy the current target, then construct the target of
+     * type `Functor` in place from `args...`.
+     * @note `args...` MUST NOT refer to the current target.
+     */
+    template <typename Functor, typename... Args>
+    Functor& emplace(Args&&... args) noexcept
+    {
+      MyWrapper::template M_check_emplace<Functor, Args...>();
+
+      this->template M_assign<Functor>(std::forward<Args>(args)...);
+      return M_functor.template M_access<Functor>();
+    }
+
+    // Swap the targets. (At most 3 manager calls)
+    using MyWrapper::swap;
+
+    // Destroy the target.
+    EMBED_INLINE MoveOnlyFn& operator=(std::nullptr_t) noexcept
+    {
+      M_reset();
+      return *this;
+    }
+
+    // Destroy the target, then relocate the target of `fn`.
+    MoveOnlyFn& operator=(MoveOnlyFn&& fn) noexcept
+    {
+      return this->M_move_assign(fn);
+    }
+
+    /// @brief Replace the target by a copy of `func`, which may be owned by
+    /// the current target. Built in place if the current target is trivial.
+    template <typename Functor,
+      typename DecayFunc = MoveOnlyFn::DecayFunc_t<Functor> >
+    EMBED_INLINE MoveOnlyFn& operator=(Functor&& func) noexcept
+    {
+      MyWrapper::template M_check_target<Functor>();
+
+      static_assert(std::is_nothrow_constructible<DecayFunc, Functor>::value,
+        "embed::MoveOnlyFn target must be NO-THROW constructible from the "
+        "assignment argument");
+
+      return this->template M_assign_from<DecayFunc>(std::forward<Functor>(func));
+    }
+
+    // check if the embed::MoveOnlyFn is empty.
+    EMBED_INLINE constexpr bool is_empty() const noexcept
+    {
+      return !M_has_target();
+    }
+
+    // `true` if the embed::MoveOnlyFn is not empty.
+    EMBED_INLINE constexpr explicit operator bool() const noexcept
+    {
+      return !is_empty();
+    }
+
+  }; // end MoveOnlyFn
+
+
+  /**
+   * @brief   A polymorphic wrapper for callable object which is never empty.
+   * It can only be built from a valid callable object, so `operator()` is
+   * an unconditional indirect call without the empty check and the
+   * `throw_bad_function_call_or_abort()` cold path. A null function pointer
+   * (or an empty embed::Fn) is rejected once, at construction.
+   * A moved-from embed::NonnullFn points at the empty sentinel, calling it
+   * goes to `throw_bad_function_call_or_abort()`.
+   * @note    Only use stack memory. NO HEAP MEMORY!
+   */
+  template <typename Signature, std::size_t BufSize, bool FastCall>
+  class NonnullFn
+  : private detail::FnWrapper<NonnullFn<Signature, BufSize, FastCall>, Signature>
+  , public detail::FnQualifierHelper<Signature, BufSize, FastCall, true, false>
+  {
+  private:
+    using MyWrapper = detail::FnWrapper<NonnullFn, Signature>;
+
+    using MyQualifierHelper = detail::FnQualifierHelper<Signature, BufSize, FastCall, true, false>;
+
+    using FnTraits = detail::FnToolBox::FnTraits;
+
+    // The embed::Fn with the same layout.
+    using MyFn = Fn<Signature, BufSize, FastCall>;
+
+    template <typename Functor>
+    using DecayFunc_t = typename std::enable_if<
+      !std::is_same<NonnullFn, FnTraits::remove_cvref_t<Functor> >::value
+      && !FnTraits::is_Fn_and_similar<Signature, FnTraits::remove_cvref_t<Functor> >::value,
+      typename std::decay<Functor>::type
+    >::type;
+
+    template <typename Functor>
+    using MyTargetManager = typename std::conditional<
+      std::is_copy_constructible<Functor>::value,
+      typename MyQualifierHelper::template Copyable<Functor>,
+      typename MyQualifierHelper::template MoveOnly<Functor>
+    >::type;
+
+    template <typename Functor>
+    using Callable = typename MyQualifierHelper::template Callable<Functor>;
+
+    using MyEmpty = typename MyQualifierHelper::Empty;
+
+    // The storage and lifecycle code shared by the wrappers.
+    template <typename Derived, typename Sig>
+    friend class detail::FnWrapper;
+
+    using MyWrapper::M_clone_from;
+    using MyWrapper::M_relocate_from;
+    using MyWrapper::M_destroy;
+
+    using MyQualifierHelper::M_functor;
+    using MyQualifierHelper::M_manager;
+    using MyQualifierHelper::M_get_invoker;
+    using MyQualifierHelper::M_set_target;
+
+    using RetType = typename FnTraits::unwrap_signature<Signature>::ret;
+
+    // Point at the empty sentinel, even if @b EMBED_FN_EMPTY_SENTINEL is false.
+    // (The target has been relocated or destroyed before.)
+    EMBED_INLINE void M_set_empty() noexcept
+    {
+      M_set_target(&MyEmpty::M_table, &MyEmpty::M_invoke);
+    }
+
+    // `M_manager` is never `nullptr`.
+    EMBED_INLINE bool M_trivial_target() const noexcept
+    {
+      return M_manager->M_trivial;
+    }
+
+    // Take the descriptor (not the target) of `fn`. (embed::NonnullFn
+    // or the embed::Fn with the same layout)
+    template <typename Wrapper>
+    EMBED_INLINE void M_set_target_of(const Wrapper& fn) noexcept
+    {
+      M_set_target(fn.M_manager, fn.M_get_invoker());
+    }
+
+    // Construct the target `Functor` in `M_functor` from `args...`.
+    // A null function pointer (or an empty embed::Fn) is the only runtime
+    // check, and it is folded away for the other targets. `*this` MUST be trivial.
+    template <typename Functor, typename... Args>
+    EMBED_INLINE void M_construct(Args&&... args)
+    {
+      if EMBED_UNLIKELY(!MyWrapper::template M_construct<Functor>(std::forward<Args>(args)...))
+      {
+        M_set_empty();
+        detail::throw_bad_function_call_or_abort(); /* may not throw exception */
+      }
+    }
+
+  public:
+    // Get the return type.
+    using result_type = RetType;
+
+    // The `BufSize` of this embed::NonnullFn object.
+    static constexpr std::size_t buffer_size = BufSize;
+
+    // `true` if this embed::NonnullFn uses the fast layout (stores the invoker).
+    static constexpr bool is_fast_mode = FastCall;
+
+  public:
+    // Destroy the functor, call functor's destructor.
+    EMBED_INLINE ~NonnullFn() noexcept
+    {
+      M_destroy();
+    }
+
+    // No empty embed::NonnullFn.
+    NonnullFn() = delete;
+    NonnullFn(std::nullptr_t) = delete;
+
+    // Copy the target.
+    NonnullFn(const NonnullFn& fn) noexcept
+    {
+      M_clone_from(fn);
+    }
+
+    // Relocate the target, `fn` is moved-from.
+    NonnullFn(NonnullFn&& fn) noexcept
+    {
+      M_relocate_from(fn);
+    }
+
+    // Take the target of embed::Fn, which is checked once here.
+    // (A template, so that no conversion to embed::Fn is considered.)
+    template <typename OtherFn,
+      typename std::enable_if<std::is_same<OtherFn, MyFn>::value, bool>::type = true>
+    explicit NonnullFn(const OtherFn& fn)
+    {
+      if EMBED_UNLIKELY(fn.is_empty())
+        detail::throw_bad_function_call_or_abort(); /* may not throw exception */
+      M_clone_from(fn);
+    }
+
+    // Take the target of embed::Fn, which is checked once here.
+    template <typename OtherFn,
+      typename std::enable_if<std::is_same<OtherFn, MyFn>::value, bool>::type = true>
+    explicit NonnullFn(OtherFn&& fn)
+    {
+      if EMBED_UNLIKELY(fn.is_empty())
+        detail::throw_bad_function_call_or_abort(); /* may not throw exception */
+      M_relocate_from(fn);
+    }
+
+    /**
+     * @brief Builds a NonnullFn that targets the incoming function object.
+     * REQUIRE:
+     * 1. `decltype(func)` must be Callable.
+     * 2. `std::decay<decltype(func)>::type` must be nothrow constructible from
+     * the type `decltype(func)` object.
+     * 3. A non-copyable target must be passed as rvalue.
+     * @note A null function pointer is rejected by `throw_bad_function_call_or_abort()`.
+     */
+    template <typename Functor,
+      typename DecayFunctor = NonnullFn::DecayFunc_t<Functor> >
+    NonnullFn(Functor&& func)
+    {
+      MyWrapper::template M_check_target<Functor>();
+
+      static_assert(std::is_copy_constructible<DecayFunctor>::value
+        || !std::is_reference<Functor>::value,
+        "embed::NonnullFn target must be copy-constructible");
+
+      static_assert(std::is_nothrow_constructible<DecayFunctor, Functor>::value,
+        "embed::NonnullFn target must be NO-THROW constructible from the "
+        "constructor argument");
+
+      M_construct<DecayFunctor>(std::forward<Functor>(func));
+    }
+
+    // Construct the target of type `Functor` in place from `args...`.
+    template <typename Functor, typename... Args>
+    explicit NonnullFn(in_place_type_t<Functor>, Args&&... args)
+    {
+      M_set_empty();
+      emplace<Functor>(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroy the current target, then construct the target of
+     * type `Functor` in place from `args...`.
+     * @note `args...` MUST NOT refer to the current target.
+     */
+    template <typename Functor, typename... Args>
+    Functor& emplace(Args&&... args)
+    {
+      MyWrapper::template M_check_emplace<Functor, Args...>();
+
+      this->template M_assign<Functor>(std::forward<Args>(args)...);
+      return M_functor.template M_access<Functor>();
+    }
+
+    // Swap the targets. (At most 3 manager calls)
+    using MyWrapper::swap;
+
+    // Destroy the target, then relocate the target of `fn`.
+    NonnullFn& operator=(NonnullFn&& fn) noexcept
+    {
+      return this->M_move_assign(fn);
+    }
+
+    // Copy the target of `fn`.
+    NonnullFn& operator=(const NonnullFn& fn) noexcept
+    {
+      return this->M_copy_assign(fn);
+    }
+
+    /// @brief Replace the target by a copy of `func`, which may be owned by
+    /// the current target. Built in place if the current target is trivial.
+    template <typename Functor,
+      typename DecayFunc = NonnullFn::DecayFunc_t<Functor> >
+    EMBED_INLINE NonnullFn& operator=(Functor&& func)
+    {
+      MyWrapper::template M_check_target<Functor>();
+
+      static_assert(std::is_copy_constructible<DecayFunc>::value
+        || !std::is_reference<Functor>::value,
+        "embed::NonnullFn target must be copy-constructible");
+
+      static_assert(std::is_nothrow_constructible<DecayFunc, Functor>::value,
+        "embed::NonnullFn target must be NO-THROW constructible from the "
+        "assignment argument");
+
+      return this->template M_assign_from<DecayFunc>(std::forward<Functor>(func));
+    }
+
+  }; // end NonnullFn
+
+
+namespace detail {
+
+  /**
+   * @c FnOverloadEntry
+   * @brief The types of one Signature of `embed::OverloadFn`. They are the
+   * types of the compact `FnQualifierHelper` with the same Signature, only
+   * the storage is not used. (The buffer and the table belong to OverloadFn)
+   */
+  template <typename Signature, std::size_t BufSize>
+  struct FnOverloadEntry
+  : private FnQualifierHelper<Signature, BufSize, false>
+  {
+  private:
+    using Base = FnQualifierHelper<Signature, BufSize, false>;
+
+    using FnTraits = FnToolBox::FnTraits;
+
+    static_assert(!FnTraits::get_signature_qualifier<Signature>::is_volatile,
+      "embed::OverloadFn does not support the volatile Signature");
+
+  public:
+    using typename Base::Invoker_Type;
+    using typename Base::Empty;
+
+    template <typename Functor>
+    using Invoker = typename Base::template Invoker<Functor>;
+
+    template <typename Functor>
+    using Manager = typename Base::template Copyable<Functor>;
+
+    template <typename Functor>
+    static EMBED_INLINE void M_check_target() noexcept
+    {
+      static_assert(Base::template Callable<Functor>::value,
+        "embed::OverloadFn requires the Functor is callable with every Signature");
+
+      static_assert(
+        !(FnTraits::get_signature_qualifier<Signature>::is_const
+          && FnTraits::is_class_and_has_call_operator<
+            typename FnTraits::unwrap_signature<Signature>::pure_sig,
+            Functor>::not_const_q),
+        "embed::OverloadFn requires the signature is non-const-qualified because the"
+        " Functor::operator() is not const-qualified");
+    }
+  };
+
+  /**
+   * @c FnOverloadCall
+   * @brief One `operator()` per Signature. Each level inherits the next one,
+   * and brings its `operator()` into scope, so they are overloaded.
+   * `Derived` is the embed::OverloadFn which owns the buffer and the table.
+   * @note The qualifiers of `operator()` can not be deduced, so one
+   * specialization per qualifier is generated. It only forwards to
+   * `Derived::M_call_at<Index>`.
+   */
+  template <typename Derived, std::size_t BufSize,
+    std::size_t Index, typename... Signatures>
+  struct FnOverloadCall
+  {
+  private:
+    struct M_unused_tag {};
+
+  public:
+    // The end of the overload set.
+    void operator() (M_unused_tag) const = delete;
+  };
+
+  /**
+   * @c FnOverloadGet
+   * @brief Get the `Index`-th invoker of `FnOverloadInvokers`.
+   */
+  template <std::size_t Index>
+  struct FnOverloadGet
+  {
+    template <typename Invokers>
+    static EMBED_INLINE constexpr auto M_get(const Invokers& invokers) noexcept
+    -> decltype(FnOverloadGet<Index - 1>::M_get(invokers.M_tail))
+    { return FnOverloadGet<Index - 1>::M_get(invokers.M_tail); }
+  };
+
+  template <>
+  struct FnOverloadGet<0>
+  {
+    template <typename Invokers>
+    static EMBED_INLINE constexpr auto M_get(const Invokers& invokers) noexcept
+    -> decltype(invokers.M_head)
+    { return invokers.M_head; }
+  };
+
+#define EMBED_FN_OVERLOAD_CODE_IMPL(C, V, REF, NOEXC, NOEXC_B)                          \
+  template <typename Derived, std::size_t BufSize, std::size_t Index,                   \
+    typename RetType, typename... ArgsType, typename... Signatures>                     \
+  struct FnOverloadCall<Derived, BufSize, Index,                                        \
+    RetType(ArgsType...) C V REF NOEXC, Signatures...>                                  \
+  : public FnOverloadCall<Derived, BufSize, Index + 1, Signatures...>                   \
+  {                                                                                     \
+    using FnOverloadCall<Derived, BufSize, Index + 1, Signatures...>::operator();       \
+    EMBED_INLINE RetType operator() (ArgsType... args) C V REF                          \
+    EMBED_FN_CASE_NOEXCEPT_IF(NOEXC_B) {                                                \
+      return static_cast<const Derived&>(*this).template M_call_at<Index, RetType>(     \
+        std::forward<ArgsType>(args)...);                                               \
+    }                                                                                   \
+  };
+
+#define EMBED_FN_OVERLOAD_CODE(C, V, REF)                                 \
+  EMBED_FN_OVERLOAD_CODE_IMPL(C, V, REF, , false)
+
+  // Use macro to generate code. (Overload for `FnOverloadCall`)
+  EMBED_FN_GENERATE_CODE_C_V_REF(EMBED_FN_OVERLOAD_CODE)
+
+#if EMBED_CXX_VERSION >= 201703L
+# undef EMBED_FN_OVERLOAD_CODE
+# define EMBED_FN_OVERLOAD_CODE(C, V, REF)                                \
+  EMBED_FN_OVERLOAD_CODE_IMPL(C, V, REF, noexcept, true)
+
+  // Overload for the noexcept Signature. (Since C++17)
+  EMBED_FN_GENERATE_CODE_C_V_REF(EMBED_FN_OVERLOAD_CODE)
+#endif
+
+#undef EMBED_FN_OVERLOAD_CODE
+#undef EMBED_FN_OVERLOAD_CODE_IMPL
+
+  /**
+   * @c FnOverloadInvokers
+   * @brief The invokers of one functor type, one per Signature,
+   * laid out next to each other. (Aggregate, filled at compile time)
+   */
+  template <std::size_t BufSize, typename... Signatures>
+  struct FnOverloadInvokers
+  {
+    template <typename Functor>
+    static constexpr FnOverloadInvokers M_make() noexcept { return {}; }
+
+    static constexpr FnOverloadInvokers M_make_empty() noexcept { return {}; }
+  };
+
+  template <std::size_t BufSize, typename Signature, typename... Signatures>
+  struct FnOverloadInvokers<BufSize, Signature, Signatures...>
+  {
+    using Entry = FnOverloadEntry<Signature, BufSize>;
+    using Next = FnOverloadInvokers<BufSize, Signatures...>;
+
+    typename Entry::Invoker_Type  M_head;
+    Next                          M_tail;
+
+    template <typename Functor>
+    static constexpr FnOverloadInvokers M_make() noexcept
+    {
+      return { &Entry::template Invoker<Functor>::M_invoke,
+        Next::template M_make<Functor>() };
+    }
+
+    static constexpr FnOverloadInvokers M_make_empty() noexcept
+    { return { &Entry::Empty::M_invoke, Next::M_make_empty() }; }
+  };
+
+  /**
+   * @c FnOverloadTable
+   * @brief The descriptor that `embed::OverloadFn::M_manager` points at.
+   * The invokers of all Signatures, then one set of lifecycle entries.
+   */
+  template <std::size_t BufSize, typename... Signatures>
+  struct FnOverloadTable
+  {
+    using Lifecycle_Type = FnToolBox::FnManagerTable<void (*) (), FnFunctor<BufSize>>;
+
+    FnOverloadInvokers<BufSize, Signatures...>  M_invokers; // Invoke the M_functor
+    typename Lifecycle_Type::Clone_Type         M_clone;    // Clone the M_functor (dest <- src)
+    typename Lifecycle_Type::Relocate_Type      M_relocate; // Move the M_functor (dest <- src), destroy src
+    typename Lifecycle_Type::Destroy_Type       M_destroy;  // Destroy the M_functor
+    bool                                        M_trivial;  // Copy / relocate / destroy as raw bytes
+  };
+
+  /**
+   * @c FnOverloadManager
+   * @brief Remember the type of the functor for `embed::OverloadFn`.
+   * The lifecycle entries (and the requirements on size, alignment and
+   * nothrow copy) come from the manager of the first Signature.
+   */
+  template <typename Functor, std::size_t BufSize,
+    typename Signature, typename... Signatures>
+  struct FnOverloadManager
+  {
+    using Manager = typename FnOverloadEntry<Signature, BufSize>::template Manager<Functor>;
+
+    /// @e M_table
+    static constexpr FnOverloadTable<BufSize, Signature, Signatures...> M_table = {
+      FnOverloadInvokers<BufSize, Signature, Signatures...>::template M_make<Functor>(),
+      Manager::M_table.M_clone,
+      Manager::M_table.M_relocate,
+      Manager::M_table.M_destroy,
+      Manager::M_table.M_trivial
+    };
+  };
+
+  /**
+   * @c FnOverloadEmpty
+   * @brief The sentinel descriptor of an empty `embed::OverloadFn`,
+   * only used when @b EMBED_FN_EMPTY_SENTINEL is true.
+   */
+  template <std::size_t BufSize, typename... Signatures>
+  struct FnOverloadEmpty
+  {
+    /// @e M_table
+    static constexpr FnOverloadTable<BufSize, Signatures...> M_table = {
+      FnOverloadInvokers<BufSize, Signatures...>::M_make_empty(),
+      nullptr,
+      nullptr,
+      nullptr,
+      true
+    };
+  };
+
+#if EMBED_CXX_VERSION < 201703L
+  template <typename Functor, std::size_t BufSize,
+    typename Signature, typename... Signatures>
+  constexpr FnOverloadTable<BufSize, Signature, Signatures...>
+  FnOverloadManager<Functor, BufSize, Signature, Signatures...>::M_table;
+
+  template <std::size_t BufSize, typename... Signatures>
+  constexpr FnOverloadTable<BufSize, Signatures...>
+  FnOverloadEmpty<BufSize, Signatures...>::M_table;
+#endif
+
+} // end namespace embed::detail
+
+  /**
+   * @brief   A polymorphic wrapper for callable object with several Signatures.
+   * One buffer, one manager table, and one overloaded `operator()` per
+   * Signature. The invokers of all Signatures are stored in the table.
+   * @note    Only use stack memory. NO HEAP MEMORY!
+   * @example embed::OverloadFn<8, void(int), void(float)> fn = visitor{};
+   */
+  template <std::size_t BufSize, typename... Signatures>
+  class OverloadFn
+  : private detail::FnWrapper<OverloadFn<BufSize, Signatures...> >
+  , public detail::FnOverloadCall<OverloadFn<BufSize, Signatures...>, BufSize, 0, Signatures...>
+  {
+    static_assert(sizeof...(Signatures) != 0,
+      "embed::OverloadFn requires at least one Signature");
+
+  private:
+    using MyWrapper = detail::FnWrapper<OverloadFn>;
+
+    using FnTraits = detail::FnToolBox::FnTraits;
+
+    // Each `operator()` calls `M_call_at`.
+    template <typename, std::size_t, std::size_t, typename...>
+    friend struct detail::FnOverloadCall;
+
+    // The storage and lifecycle code shared by the wrappers.
+    template <typename Derived, typename Sig>
+    friend class detail::FnWrapper;
+
+    template <typename Functor>
+    using DecayFunc_t = typename std::enable_if<
+      !std::is_same<OverloadFn, FnTraits::remove_cvref_t<Functor> >::value,
+      typename std::decay<Functor>::type
+    >::type;
+
+    template <typename Functor>
+    using MyManager = detail::FnOverloadManager<Functor, BufSize, Signatures...>;
+
+    // The lifecycle of the target `Functor` comes from the manager
+    // of the first Signature.
+    template <typename Functor>
+    using MyTargetManager = typename MyManager<Functor>::Manager;
+
+    using MyEmpty = detail::FnOverloadEmpty<BufSize, Signatures...>;
+
+    using Manager_Type = const detail::FnOverloadTable<BufSize, Signatures...>*;
+
+    // The empty `M_manager`.
+#if ( EMBED_FN_EMPTY_SENTINEL == true )
+    static constexpr Manager_Type M_empty_manager() noexcept
+    { return &MyEmpty::M_table; }
+#else
+    static constexpr Manager_Type M_empty_manager() noexcept
+    { return nullptr; }
+#endif
+
+    // The `M_functor` store the callable object.
+    detail::FnFunctor<BufSize>  M_functor{};
+
+    // The `M_manager` describes how to invoke / copy / move / destroy the `M_functor`.
+    Manager_Type                M_manager{M_empty_manager()};
+
+    // Every Signature checks the target.
+    template <typename Functor>
+    static EMBED_INLINE void M_check_target() noexcept
+    {
+      using expand = int[];
+      (void)expand{ 0,
+        (detail::FnOverloadEntry<Signatures, BufSize>::template M_check_target<Functor>(), 0)... };
+    }
+
+    // Invoke the target with the `Index`-th invoker. (See `FnOverloadCall`)
+    template <std::size_t Index, typename RetType, typename... Args>
+    EMBED_INLINE RetType M_call_at(Args&&... args) const
+    {
+#if ( EMBED_FN_EMPTY_SENTINEL == true )
+      return detail::FnOverloadGet<Index>::M_get(M_manager->M_invokers)(
+        M_functor, std::forward<Args>(args)...);
+#else
+      if EMBED_LIKELY(M_manager != nullptr)
+        return detail::FnOverloadGet<Index>::M_get(M_manager->M_invokers)(
+          M_functor, std::forward<Args>(args)...);
+      else
+        detail::throw_bad_function_call_or_abort(); /* may not throw exception */
+#endif
+    }
+
+    using MyWrapper::M_clone_from;
+    using MyWrapper::M_relocate_from;
+    using MyWrapper::M_destroy;
+    using MyWrapper::M_reset;
+
+    EMBED_INLINE Manager_Type M_table() const noexcept
+    { return M_manager; }
+
+    EMBED_INLINE constexpr bool M_has_target() const noexcept
+    { return M_manager != M_empty_manager(); }
+
+    EMBED_INLINE void M_set_empty() noexcept
+    { M_manager = M_empty_manager(); }
+
+    EMBED_INLINE void M_set_target_of(const OverloadFn& fn) noexcept
+    { M_manager = fn.M_manager; }
+
+    template <typename Manager, typename Functor>
+    EMBED_INLINE void M_set_target_to() noexcept
+    {
+      static_assert(std::is_copy_constructible<Functor>::value,
+        "embed::OverloadFn target must be copy-constructible");
+
+      M_manager = &OverloadFn::template MyManager<Functor>::M_table;
+    }
+
+  public:
+    // The `BufSize` of this embed::OverloadFn object.
+    static constexpr std::size_t buffer_size = BufSize;
+
+    // The number of Signatures.
+    static constexpr std::size_t signature_count = sizeof...(Signatures);
+
+  public:
+    // Destroy the functor, call functor's destructor.
+    EMBED_INLINE ~OverloadFn() noexcept
+    {
+      M_destroy();
+    }
+
+    // Create an empty function wrapper.
+    EMBED_INLINE OverloadFn() noexcept = default;
+
+    // Create an empty function wrapper.
+    EMBED_INLINE OverloadFn(std::nullptr_t) noexcept {}
+
+    // Copy the target.
+    OverloadFn(const OverloadFn& fn) noexcept
+    {
+      M_clone_from(fn);
+    }
+
+    // Relocate the target, and `fn` becomes empty.
+    OverloadFn(OverloadFn&& fn) noexcept
+    {
+      M_relocate_from(fn);
+    }
+
+    /**
+     * @brief Builds an OverloadFn that targets a copy of the incoming
+     * function object.
+     * REQUIRE:
+     * 1. `decltype(func)` must be callable with every Signature.
+     * 2. `std::decay<decltype(func)>::type` must be nothrow copy constructible.
+     * 3. `std::decay<decltype(func)>::type` must be nothrow constructible from
+     * the type `decltype(func)` object.
+     */
+    template <typename Functor,
+      typename DecayFunctor = OverloadFn::DecayFunc_t<Functor> >
+    OverloadFn(Functor&& func) noexcept
+    {
+      M_check_target<DecayFunctor>();
+
+      static_assert(std::is_nothrow_constructible<DecayFunctor, Functor>::value,
+        "embed::OverloadFn target must be NO-THROW constructible from the "
+        "constructor argument");
+
+      this->template M_construct<DecayFunctor>(std::forward<Functor>(func));
+    }
+
+    // Construct the target of type `Functor` in place from `args...`.
+    template <typename Functor, typename... Args>
+    explicit OverloadFn(in_place_type_t<Functor>, Args&&... args) noexcept
+    {
+      emplace<Functor>(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroy the current target, then construct the target of
+     * type `Functor` in place from `args...`.
+     * @note `args...` MUST NOT refer to the current target.
+     */
+    template <typename Functor, typename... Args>
+    Functor& emplace(Args&&... args) noexcept
+    {
+      MyWrapper::template M_check_emplace<Functor, Args...>();
+
+      this->template M_assign<Functor>(std::forward<Args>(args)...);
+      return M_functor.template M_access<Functor>();
+    }
+
+    // Swap the targets. (At most 3 manager calls)
+    using MyWrapper::swap;
+
+    // Destroy the target.
+    EMBED_INLINE OverloadFn& operator=(std::nullptr_t) noexcept
+    {
+      M_reset();
+      return *this;
+    }
+
+    // Destroy the target, then relocate the target of `fn`.
+    OverloadFn& operator=(OverloadFn&& fn) noexcept
+    {
+      return this->M_move_assign(fn);
+    }
+
+    // Copy the target of `fn`.
+    OverloadFn& operator=(const OverloadFn& fn) noexcept
+    {
+      return this->M_copy_assign(fn);
+    }
+
+    /// @brief Replace the target by a copy of `func`, which may be owned by
+    /// the current target. Built in place if the current target is trivial.
+    template <typename Functor,
+      typename DecayFunc = OverloadFn::DecayFunc_t<Functor> >
+    EMBED_INLINE OverloadFn& operator=(Functor&& func) noexcept
+    {
+      M_check_target<DecayFunc>();
+
+      static_assert(std::is_nothrow_constructible<DecayFunc, Functor>::value,
+        "embed::OverloadFn target must be NO-THROW constructible from the "
+        "assignment argument");
+
+      return this->template M_assign_from<DecayFunc>(std::forward<Functor>(func));
+    }
+
+    // check if the embed::OverloadFn is empty.
+    EMBED_INLINE constexpr bool is_empty() const noexcept
+    {
+      return !M_has_target();
+    }
+
+    // `true` if the embed::OverloadFn is not empty.
+    EMBED_INLINE constexpr explicit operator bool() const noexcept
+    {
+      return !is_empty();
+    }
+
+  }; // end OverloadFn
+
+
+  /**
+   * @brief   A trivially copyable polymorphic wrapper for trivially copyable
+   * and trivially destructible callable object. It has the same layout as
+   * embed::Fn, but the lifecycle entries of the manager table are never
+   * called: copying, moving and destroying are raw byte operations, so it can
+   * be `memcpy`'d, put in `std::atomic` or placed in shared memory.
+   * @note    Only use stack memory. NO HEAP MEMORY!
+   */
+  template <typename Signature, std::size_t BufSize, bool FastCall>
+  class TrivialFn
+  : private detail::FnWrapper<TrivialFn<Signature, BufSize, FastCall>, Signature>
+  , public detail::FnQualifierHelper<Signature, BufSize, FastCall>
+  {
+  private:
+    using MyWrapper = detail::FnWrapper<TrivialFn, Signature>;
+
+    using MyQualifierHelper = detail::FnQualifierHelper<Signature, BufSize, FastCall>;
+
+    using FnTraits = detail::FnToolBox::FnTraits;
+
+    // The embed::Fn with the same layout.
+    using MyFn = Fn<Signature, BufSize, FastCall>;
+
+    template <typename Functor>
+    using DecayFunc_t = typename std::enable_if<
+      !std::is_same<TrivialFn, FnTraits::remove_cvref_t<Functor> >::value,
+      typename std::decay<Functor>::type
+    >::type;
+
+    template <typename Functor>
+    using MyTargetManager = typename MyQualifierHelper::template Copyable<Functor>;
+
+    template <typename Functor>
+    using Callable = typename MyQualifierHelper::template Callable<Functor>;
+
+    // The storage and lifecycle code shared by the wrappers.
+    template <typename Derived, typename Sig>
+    friend class detail::FnWrapper;
+
+    using MyQualifierHelper::M_functor;
+    using MyQualifierHelper::M_manager;
+    using MyQualifierHelper::M_get_invoker;
+    using MyQualifierHelper::M_set_target;
+    using MyQualifierHelper::M_set_empty;
+    using MyQualifierHelper::M_empty_manager;
+    using MyQualifierHelper::M_has_target;
+
+    using RetType = typename FnTraits::unwrap_signature<Signature>::ret;
+
+  public:
+    // Get the return type.
+    using result_type = RetType;
+
+    // The `BufSize` of this embed::TrivialFn object.
+    static constexpr std::size_t buffer_size = BufSize;
+
+    // `true` if this embed::TrivialFn uses the fast layout (stores the invoker).
+    static constexpr bool is_fast_mode = FastCall;
+
+  public:
+    // Create an empty function wrapper.
+    EMBED_INLINE TrivialFn() noexcept = default;
+
+    // Create an empty function wrapper.
+    EMBED_INLINE TrivialFn(std::nullptr_t) noexcept {}
+
+    /**
+     * @brief Builds a TrivialFn that targets a copy of the incoming
+     * function object.
+     * REQUIRE:
+     * 1. `decltype(func)` must be Callable.
+     * 2. `std::decay<decltype(func)>::type` must be trivially copyable
+     * and trivially destructible.
+     */
+    template <typename Functor,
+      typename DecayFunctor = TrivialFn::DecayFunc_t<Functor>,
+      typename = typename std::enable_if<!FnTraits::is_Fn_and_similar<
+        Signature, FnTraits::remove_cvref_t<Functor>
+      >::value>::type>
+    TrivialFn(Functor&& func) noexcept
+    {
+      MyWrapper::template M_check_target<Functor>();
+
+      static_assert(std::is_trivially_copyable<DecayFunctor>::value
+        && std::is_copy_constructible<DecayFunctor>::value
+        && std::is_trivially_destructible<DecayFunctor>::value,
+        "embed::TrivialFn target must be copyable, trivially copyable and trivially"
+        " destructible (use embed::function for other targets)");
+
+      this->template M_construct<DecayFunctor>(std::forward<Functor>(func));
+    }
+
+    // Reset to empty. (Nothing to destroy)
+    EMBED_INLINE TrivialFn& operator=(std::nullptr_t) noexcept
+    {
+      M_set_empty();
+      return *this;
+    }
+
+    // Replace the target. (Nothing to destroy)
+    template <typename Functor,
+      typename = TrivialFn::DecayFunc_t<Functor>,
+      typename = typename std::enable_if<!FnTraits::is_Fn_and_similar<
+        Signature, FnTraits::remove_cvref_t<Functor>
+      >::value>::type>
+    EMBED_INLINE TrivialFn& operator=(Functor&& func) noexcept
+    {
+      return *this = TrivialFn(std::forward<Functor>(func));
+    }
+
+    // Swap the targets. (Raw bytes)
+    EMBED_INLINE void swap(TrivialFn& fn) noexcept
+    {
+      TrivialFn tmp = fn;
+      fn = *this;
+      *this = tmp;
+    }
+
+    // Convert into the embed::Fn with the same layout. (Raw bytes)
+    EMBED_INLINE operator MyFn() const noexcept
+    {
+      MyFn fn;
+      fn.M_functor = M_functor;
+      fn.M_set_target(M_manager, M_get_invoker());
+      return fn;
+    }
+
+    // check if the embed::TrivialFn is empty.
+    EMBED_INLINE constexpr bool is_empty() const noexcept
+    {
+      return !M_has_target();
+    }
+
+    // `true` if the embed::TrivialFn is not empty.
+    EMBED_INLINE constexpr explicit operator bool() const noexcept
+    {
+      return !is_empty();
+    }
+
+  }; // end TrivialFn
+
+
+namespace detail {
+
+  /**
+   * @c FnIndexRegistry
+   * @brief The manager table of embed::IndexedFn for one `Empty` manager
+   * (one signature, buffer size and alignment). Entry 0 is the empty
+   * sentinel, and each target type registers its manager at its first use.
+   */
+  template <typename Empty, typename Index>
+  struct FnIndexRegistry
+  {
+    using Table_Type = typename Empty::Table_Type;
+
+    static_assert(static_cast<std::size_t>(static_cast<Index>(EMBED_FN_INDEX_CAPACITY - 1))
+      == EMBED_FN_INDEX_CAPACITY - 1,
+      "embed::IndexedFn requires the Index to hold `EMBED_FN_INDEX_CAPACITY - 1`");
+
+    static const Table_Type*        S_tables[EMBED_FN_INDEX_CAPACITY];
+    static std::atomic<std::size_t> S_count; // Registered, except the empty one
+
+    /// @e M_register
+    static Index M_register(const Table_Type* table) noexcept
+    {
+      std::size_t index = S_count.fetch_add(1) + 1;
+      if EMBED_UNLIKELY(index >= EMBED_FN_INDEX_CAPACITY)
+        index_exhausted_handler();
+      S_tables[index] = table;
+      return static_cast<Index>(index);
+    }
+
+    /// @e M_index_of
+    // The index of `Manager`, registered at the first call.
+    template <typename Manager>
+    static Index M_index_of() noexcept
+    {
+      static const Index index = M_register(&Manager::M_table);
+      return index;
+    }
+  };
+
+  template <typename Empty, typename Index>
+  const typename FnIndexRegistry<Empty, Index>::Table_Type*
+  FnIndexRegistry<Empty, Index>::S_tables[EMBED_FN_INDEX_CAPACITY] = { &Empty::M_table };
+
+  template <typename Empty, typename Index>
+  std::atomic<std::size_t> FnIndexRegistry<Empty, Index>::S_count;
+
+  /**
+   * @brief Help "embed::IndexedFn" handle various different modifiers.
+   */
+  template <typename Signature, std::size_t, typename, std::size_t>
+  struct FnIndexedHelper
+  {
+    static_assert(
+      !std::is_void<FnToolBox::FnTraits::void_t<Signature>>::value /* always false */,
+      "The Signature must be like `Ret(Args...) [const | volatile | & | &&] [noexcept]`."
+      " And your signature format is incorrect.");
+  };
+
+#define EMBED_FN_INDEXED_HELPER_CODE_IMPL(C, V, REF, NOEXC, NOEXC_B)                      \
+  template <typename RetType, std::size_t BufSize, typename Index,                        \
+    std::size_t Align, typename... ArgsType>                                              \
+  struct FnIndexedHelper<RetType(ArgsType...) C V REF NOEXC, BufSize, Index, Align>        \
+  {                                                                                       \
+    protected:                                                                            \
+    template <typename Functor>                                                           \
+    using Copyable = FnToolBox::FnManagerCopyable<RetType(ArgsType...),                   \
+      Functor, BufSize, std::is_volatile<V int>::value,                                   \
+      std::is_rvalue_reference<int REF>::value, NOEXC_B, Align>;                          \
+    template <typename Functor>                                                           \
+    using MoveOnly = FnToolBox::FnManagerMoveOnly<RetType(ArgsType...),                   \
+      Functor, BufSize, std::is_volatile<V int>::value,                                   \
+      std::is_rvalue_reference<int REF>::value, NOEXC_B, Align>;                          \
+    template <typename Functor>                                                           \
+    using Callable = FnToolBox::FnTraits::Callable<RetType, Functor, ArgsType...>;        \
+    using Registry = FnIndexRegistry<FnToolBox::FnEmptyManager<RetType(ArgsType...),      \
+      BufSize, std::is_volatile<V int>::value, NOEXC_B, true, Align>, Index>;             \
+    FnFunctor<BufSize, Align> M_functor{};                                                \
+    Index                     M_index{0};                                                 \
+    public:                                                                               \
+    EMBED_INLINE RetType operator() (ArgsType... args) C V REF                            \
+    EMBED_FN_CASE_NOEXCEPT_IF(NOEXC_B)                                                    \
+    {                                                                                     \
+      return Registry::S_tables[M_index]->M_invoke(M_functor,                             \
+        std::forward<ArgsType>(args)...);                                                 \
+    }                                                                                     \
+  };
+
+#define EMBED_FN_INDEXED_HELPER_CODE(C, V, REF)                       \
+  EMBED_FN_INDEXED_HELPER_CODE_IMPL(C, V, REF, , false)
+
+  // Use macro to generate code. (Overload for `FnIndexedHelper`)
+  EMBED_FN_GENERATE_CODE_C_V_REF(EMBED_FN_INDEXED_HELPER_CODE)
+
+#if EMBED_CXX_VERSION >= 201703L
+# undef EMBED_FN_INDEXED_HELPER_CODE
+# define EMBED_FN_INDEXED_HELPER_CODE(C, V, REF)                      \
+  EMBED_FN_INDEXED_HELPER_CODE_IMPL(C, V, REF, noexcept, true)
+
+  // Overload for the noexcept Signature. (Since C++17)
+  EMBED_FN_GENERATE_CODE_C_V_REF(EMBED_FN_INDEXED_HELPER_CODE)
+#endif
+
+#undef EMBED_FN_INDEXED_HELPER_CODE
+#undef EMBED_FN_INDEXED_HELPER_CODE_IMPL
+
+} // end namespace embed::detail
+
+  /**
+   * @brief   A polymorphic wrapper that stores a small index of its manager
+   * (`Index`, 16 or 32 bits) instead of the manager pointer, next to the
+   * buffer. The managers are registered in a table per signature at the
+   * first use of each target type, and the call loads the manager from the
+   * table. An empty embed::IndexedFn has the index 0, which is the empty
+   * sentinel, so the call never checks for the empty state.
+   * The buffer is aligned to `Align` (default: the alignment of `Index`),
+   * so `embed::IndexedFn<void(), 4>` takes 8 bytes, the half of the
+   * compact embed::Fn on the 64-bit platform.
+   * @note    Only use stack memory. NO HEAP MEMORY!
+   */
+  template <typename Signature, std::size_t BufSize, typename Index, std::size_t Align>
+  class IndexedFn
+  : private detail::FnWrapper<IndexedFn<Signature, BufSize, Index, Align>, Signature>
+  , public detail::FnIndexedHelper<Signature, BufSize, Index, Align>
+  {
+  private:
+    using MyWrapper = detail::FnWrapper<IndexedFn, Signature>;
+
+    using MyHelper = detail::FnIndexedHelper<Signature, BufSize, Index, Align>;
+
+    using FnTraits = detail::FnToolBox::FnTraits;
+
+    using Registry = typename MyHelper::Registry;
+
+    template <typename Functor>
+    using DecayFunc_t = typename std::enable_if<
+      !std::is_same<IndexedFn, FnTraits::remove_cvref_t<Functor> >::value,
+      typename std::decay<Functor>::type
+    >::type;
+
+    // The manager of the target `Functor`. (copyable or move-only)
+    template <typename Functor>
+    using MyTargetManager = typename std::conditional<
+      std::is_copy_constructible<Functor>::value,
+      typename MyHelper::template Copyable<Functor>,
+      typename MyHelper::template MoveOnly<Functor>
+    >::type;
+
+    template <typename Functor>
+    using Callable = typename MyHelper::template Callable<Functor>;
+
+    // The storage and lifecycle code shared by the wrappers.
+    template <typename Derived, typename Sig>
+    friend class detail::FnWrapper;
+
+    using MyWrapper::M_clone_from;
+    using MyWrapper::M_relocate_from;
+    using MyWrapper::M_destroy;
+    using MyWrapper::M_reset;
+
+    using MyHelper::M_functor;
+    using MyHelper::M_index;
+
+    using RetType = typename FnTraits::unwrap_signature<Signature>::ret;
+
+    // The manager table of the target.
+    EMBED_INLINE const typename Registry::Table_Type* M_table() const noexcept
+    { return Registry::S_tables[M_index]; }
+
+    // The table is never `nullptr`. (The index 0 is the empty sentinel)
+    EMBED_INLINE bool M_trivial_target() const noexcept
+    { return M_table()->M_trivial; }
+
+    EMBED_INLINE void M_set_empty() noexcept
+    { M_index = 0; }
+
+    EMBED_INLINE void M_set_target_of(const IndexedFn& fn) noexcept
+    { M_index = fn.M_index; }
+
+    // Register the manager of the target at its first use.
+    template <typename Manager, typename Functor>
+    EMBED_INLINE void M_set_target_to() noexcept
+    {
+      static_assert(
+        std::is_same<const typename Registry::Table_Type*, decltype(&Manager::M_table)>::value,
+        "The library ensures that the types of the two are consistent."
+      );
+      M_index = Registry::template M_index_of<Manager>();
+    }
+
+  public:
+    // Get the return type.
+    using result_type = RetType;
+
+    // The type of the stored manager index.
+    using index_type = Index;
+
+    // The `BufSize` of this embed::IndexedFn object.
+    static constexpr std::size_t buffer_size = BufSize;
+
+  public:
+    // Destroy the target.
+    EMBED_INLINE ~IndexedFn() noexcept
+    {
+      M_destroy();
+    }
+
+    // Create an empty function wrapper.
+    EMBED_INLINE IndexedFn() noexcept = default;
+
+    // Create an empty function wrapper.
+    EMBED_INLINE IndexedFn(std::nullptr_t) noexcept {}
+
+    // Copy the target of `fn`.
+    EMBED_INLINE IndexedFn(const IndexedFn& fn) noexcept
+    { M_clone_from(fn); }
+
+    // Take the target of `fn`, which becomes empty.
+    EMBED_INLINE IndexedFn(IndexedFn&& fn) noexcept
+    { M_relocate_from(fn); }
+
+    /**
+     * @brief Builds an IndexedFn that targets a copy of the incoming
+     * function object.
+     * REQUIRE:
+     * 1. `decltype(func)` must be Callable.
+     * 2. `std::decay<decltype(func)>::type` must fit in the buffer.
+     */
+    template <typename Functor,
+      typename DecayFunctor = IndexedFn::DecayFunc_t<Functor> >
+    IndexedFn(Functor&& func) noexcept
+    {
+      MyWrapper::template M_check_target<Functor>();
+
+      static_assert(std::is_nothrow_constructible<DecayFunctor, Functor>::value,
+        "embed::IndexedFn target must be NO-THROW constructible from the "
+        "constructor argument");
+
+      this->template M_construct<DecayFunctor>(std::forward<Functor>(func));
+    }
+
+    /**
+     * @brief Destroy the current target, then construct the target
+     * `Functor` in place from `args...`.
+     * @return The reference to the new target.
+     */
+    template <typename Functor, typename... Args>
+    Functor& emplace(Args&&... args) noexcept
+    {
+      MyWrapper::template M_check_emplace<Functor, Args...>();
+
+      this->template M_assign<Functor>(std::forward<Args>(args)...);
+      return M_functor.template M_access<Functor>();
+    }
+
+    // Swap the targets. (At most 3 manager calls)
+    using MyWrapper::swap;
+
+    // Destroy the target.
+    EMBED_INLINE IndexedFn& operator=(std::nullptr_t) noexcept
+    {
+      M_reset();
+      return *this;
+    }
+
+    // Destroy the target, then take the target of `fn`.
+    IndexedFn& operator=(IndexedFn&& fn) noexcept
+    {
+      return this->M_move_assign(fn);
+    }
+
+    // Copy the target of `fn`.
+    IndexedFn& operator=(const IndexedFn& fn) noexcept
+    {
+      return this->M_copy_assign(fn);
+    }
+
+    /// @brief Replace the target by a copy of `func`, which may be owned by
+    /// the current target. Built in place if the current target is trivial.
+    template <typename Functor,
+      typename DecayFunc = IndexedFn::DecayFunc_t<Functor> >
+    EMBED_INLINE IndexedFn& operator=(Functor&& func) noexcept
+    {
+      MyWrapper::template M_check_target<Functor>();
+
+      static_assert(std::is_nothrow_constructible<DecayFunc, Functor>::value,
+        "embed::IndexedFn target must be NO-THROW constructible from the "
+        "assignment argument");
+
+      return this->template M_assign_from<DecayFunc>(std::forward<Functor>(func));
+    }
+
+    // check if the embed::IndexedFn is empty.
+    EMBED_INLINE constexpr bool is_empty() const noexcept
+    {
+      return static_cast<bool>( M_index == 0 );
+    }
+
+    // `true` if the embed::IndexedFn is not empty.
+    EMBED_INLINE constexpr explicit operator bool() const noexcept
+    {
+      return !is_empty();
+    }
+
+  }; // end IndexedFn
+
+  /**
+   * @brief `embed::function` is an alias of `embed::Fn`.
+   * @note It is encouraged to use `embed::function` instead of `embed::Fn`.
+   * `embed::function` will automatically align the BufSize.
+   * `Align` raises the alignment of the buffer for over-aligned targets,
+   * e.g. `embed::function<void(float*), 32, 32>` for a lambda capturing `__m256`.
+   */
+  template <typename Signature, std::size_t BufSize = detail::FnDefaultBufSize,
+    std::size_t Align = detail::FnDefaultAlign>
+  using function = Fn<Signature,
+    detail::FnToolBox::FnTraits::aligned_buf_size<BufSize, Align>::value,
+    detail::FnDefaultFastCall, Align>;
+
+  /**
+   * @brief `embed::fast_function` always stores the invoker in the instance.
+   * (one more pointer of RAM, one less load per call)
+   * @note It can be used together with `embed::compact_function`, and they
+   * can be converted to each other.
+   */
+  template <typename Signature, std::size_t BufSize = detail::FnDefaultBufSize,
+    std::size_t Align = detail::FnDefaultAlign>
+  using fast_function = Fn<Signature,
+    detail::FnToolBox::FnTraits::aligned_buf_size<BufSize, Align>::value, true, Align>;
+
+  /**
+   * @brief `embed::compact_function` only stores the buffer and the manager,
+   * and loads the invoker from the manager table on each call.
+   */
+  template <typename Signature, std::size_t BufSize = detail::FnDefaultBufSize,
+    std::size_t Align = detail::FnDefaultAlign>
+  using compact_function = Fn<Signature,
+    detail::FnToolBox::FnTraits::aligned_buf_size<BufSize, Align>::value, false, Align>;
+
+  /**
+   * @brief `embed::spill_function` places a target larger than the buffer
+   * in a block of `Pool` (see `embed::fixed_block_pool`), and stores only
+   * a pointer to it. The small targets still stay in the buffer.
+   * e.g. `embed::spill_function<void(), 8, embed::fixed_block_pool<64, 16>>`
+   */
+  template <typename Signature, std::size_t BufSize, typename Pool>
+  using spill_function = Fn<Signature,
+    detail::FnToolBox::FnTraits::aligned_buf_size<BufSize>::value,
+    detail::FnDefaultFastCall, detail::FnDefaultAlign, Pool>;
+
+  /**
+   * @brief `embed::move_only_function` is an alias of `embed::MoveOnlyFn`,
+   * it will automatically align the BufSize.
+   */
+  template <typename Signature, std::size_t BufSize = detail::FnDefaultBufSize>
+  using move_only_function = MoveOnlyFn<Signature,
+    detail::FnToolBox::FnTraits::aligned_buf_size<BufSize>::value>;
+
+  /**
+   * @brief `embed::nonnull_function` is an alias of `embed::NonnullFn`,
+   * it will automatically align the BufSize.
+   */
+  template <typename Signature, std::size_t BufSize = detail::FnDefaultBufSize>
+  using nonnull_function = NonnullFn<Signature,
+    detail::FnToolBox::FnTraits::aligned_buf_size<BufSize>::value>;
+
+  /**
+   * @brief `embed::overload_function` is an alias of `embed::OverloadFn`,
+   * it will automatically align the BufSize.
+   */
+  template <std::size_t BufSize, typename... Signatures>
+  using overload_function = OverloadFn<
+    detail::FnToolBox::FnTraits::aligned_buf_size<BufSize>::value, Signatures...>;
+
+  /**
+   * @brief `embed::trivial_function` is an alias of `embed::TrivialFn`,
+   * it will automatically align the BufSize.
+   */
+  template <typename Signature, std::size_t BufSize = detail::FnDefaultBufSize>
+  using trivial_function = TrivialFn<Signature,
+    detail::FnToolBox::FnTraits::aligned_buf_size<BufSize>::value>;
+
+  /**
+   * @brief `embed::compact_indexed_function` is an alias of `embed::IndexedFn`,
+   * it will automatically align the BufSize to the alignment of `Index`.
+   * The default is a 4-byte buffer and a 32-bit index (8 bytes in total).
+   */
+  template <typename Signature, std::size_t BufSize = sizeof(std::uint32_t),
+    typename Index = std::uint32_t>
+  using compact_indexed_function = IndexedFn<Signature,
+    detail::FnToolBox::FnTraits::aligned_buf_size<BufSize, alignof(Index), alignof(Index)>::value,
+    Index, alignof(Index)>;
+
+  /**
+   * @brief `embed::callback_slot_map<Signature, BufSize, Capacity>` holds up
+   * to `Capacity` callbacks (`embed::function<Signature, BufSize>`) densely
+   * packed in one array, and gives a 32-bit handle for each of them.
+   * 
+   * Insertion and erasure are O(1): erasure moves the last callback into the
+   * hole, which relocates the target through its manager (no allocation).
+   * A handle holds the slot index and the generation of the slot, and the
+   * generation changes on erasure, so a stale handle is never mistaken for
+   * a new callback in the same slot. The handle 0 (`null_handle`) is never
+   * given. Iteration (`begin` / `end`) visits the live callbacks only, in an
+   * unspecified order, and erasure during iteration moves the last one.
+   */
+  template <typename Signature, std::size_t BufSize, std::size_t Capacity>
+  class callback_slot_map
+  {
+  public:
+    using function_type = function<Signature, BufSize>;
+    using handle_type = std::uint32_t;
+    using iterator = function_type*;
+    using const_iterator = const function_type*;
+
+    // The handle that refers to no callback.
+    static constexpr handle_type null_handle = 0;
+
+  private:
+    // The number of bits of `x - 1`. (for the slot index)
+    static constexpr std::uint32_t S_bits(std::size_t x) noexcept
+    { return x <= 1 ? 0 : 1 + S_bits((x + 1) / 2); }
+
+    static constexpr std::uint32_t S_index_bits = S_bits(Capacity);
+
+    static_assert(Capacity > 0 && S_index_bits <= 24,
+      "embed::callback_slot_map requires 0 < Capacity <= 2^24"
+      " (at least 8 bits of the handle are left for the generation)");
+
+    static constexpr std::uint32_t S_index_mask =
+      (static_cast<std::uint32_t>(1) << S_index_bits) - 1;
+    static constexpr std::uint32_t S_generation_mask =
+      ~static_cast<std::uint32_t>(0) >> S_index_bits;
+
+    struct Slot
+    {
+      std::uint32_t M_generation; // Never 0, so no handle is 0
+      std::uint32_t M_index;      // Dense index if live, else next free slot
+    };
+
+    function_type M_dense[Capacity];      // Live callbacks, [0, M_size)
+    std::uint32_t M_dense_slot[Capacity]; // Dense index -> slot
+    Slot          M_slots[Capacity];
+    std::uint32_t M_free;                 // First free slot (Capacity if none)
+    std::uint32_t M_size;
+
+    // The slot of a live `handle`, or `nullptr`.
+    EMBED_INLINE const Slot* M_slot(handle_type handle) const noexcept
+    {
+      std::uint32_t slot = handle & S_index_mask;
+      if (slot >= Capacity)
+        return nullptr;
+      const Slot& s = M_slots[slot];
+      if (s.M_generation != (handle >> S_index_bits)
+        || s.M_index >= M_size || M_dense_slot[s.M_index] != slot)
+        return nullptr;
+      return &s;
+    }
+
+  public:
+    // Create an empty map, all the slots are free.
+    callback_slot_map() noexcept
+    : M_free(0), M_size(0)
+    {
+      for (std::uint32_t i = 0; i < Capacity; ++i)
+      {
+        M_slots[i].M_generation = 1;
+        M_slots[i].M_index = i + 1;
+      }
+    }
+
+    callback_slot_map(const callback_slot_map&) = delete;
+    callback_slot_map& operator=(const callback_slot_map&) = delete;
+
+    /**
+     * @brief Add a callback built from `func`.
+     * @return The handle of the callback, or `null_handle` if the map is
+     * full or the callback is empty (`nullptr`, a null function pointer or
+     * an empty embed::Fn).
+     */
+    template <typename Functor>
+    handle_type insert(Functor&& func) noexcept
+    {
+      if EMBED_UNLIKELY(M_size == Capacity)
+        return null_handle;
+
+      M_dense[M_size] = std::forward<Functor>(func);
+      if EMBED_UNLIKELY(!M_dense[M_size])
+        return null_handle;
+
+      std::uint32_t slot = M_free;
+      Slot& s = M_slots[slot];
+      M_free = s.M_index;
+
+      M_dense_slot[M_size] = slot;
+      s.M_index = M_size++;
+      return (s.M_generation << S_index_bits) | slot;
+    }
+
+    /**
+     * @brief Remove the callback of `handle`, the last callback is moved
+     * into its place.
+     * @return `false` if `handle` is stale or null.
+     */
+    bool erase(handle_type handle) noexcept
+    {
+      const Slot* live = M_slot(handle);
+      if (live == nullptr)
+        return false;
+
+      std::uint32_t slot = handle & S_index_mask;
+      std::uint32_t index = live->M_index;
+      std::uint32_t last = --M_size;
+      if (index != last)
+      {
+        M_dense[index] = std::move(M_dense[last]);
+        M_dense_slot[index] = M_dense_slot[last];
+        M_slots[M_dense_slot[index]].M_index = index;
+      }
+      else
+      {
+        M_dense[last] = nullptr;
       }
-      std::swap(M_manager, fn.M_manager);
-      std::swap(M_invoker, fn.M_invoker);
+
+      Slot& s = M_slots[slot];
+      s.M_generation = (s.M_generation + 1) & S_generation_mask;
+      if (s.M_generation == 0)
+        s.M_generation = 1;
+      s.M_index = M_free;
+      M_free = slot;
+      return true;
+    }
+
+    // Remove all the callbacks. The handles given before become stale.
+    void clear() noexcept
+    {
+      while (M_size != 0)
+        erase((M_slots[M_dense_slot[M_size - 1]].M_generation << S_index_bits)
+          | M_dense_slot[M_size - 1]);
+    }
+
+    // The callback of `handle`, or `nullptr` if `handle` is stale or null.
+    EMBED_NODISCARD function_type* find(handle_type handle) noexcept
+    {
+      const Slot* live = M_slot(handle);
+      return live == nullptr ? nullptr : &M_dense[live->M_index];
+    }
+
+    // The callback of `handle`, or `nullptr` if `handle` is stale or null.
+    EMBED_NODISCARD const function_type* find(handle_type handle) const noexcept
+    {
+      const Slot* live = M_slot(handle);
+      return live == nullptr ? nullptr : &M_dense[live->M_index];
+    }
+
+    // `true` if `handle` refers to a callback in the map.
+    EMBED_NODISCARD bool contains(handle_type handle) const noexcept
+    { return M_slot(handle) != nullptr; }
+
+    // The number of callbacks.
+    EMBED_NODISCARD std::size_t size() const noexcept
+    { return M_size; }
+
+    // The maximum number of callbacks.
+    EMBED_NODISCARD static constexpr std::size_t capacity() noexcept
+    { return Capacity; }
+
+    // `true` if there is no callback.
+    EMBED_NODISCARD bool empty() const noexcept
+    { return M_size == 0; }
+
+    // The live callbacks.
+    iterator begin() noexcept { return &M_dense[0]; }
+    iterator end() noexcept { return &M_dense[0] + M_size; }
+    const_iterator begin() const noexcept { return &M_dense[0]; }
+    const_iterator end() const noexcept { return &M_dense[0] + M_size; }
+  };
+
+namespace detail {
+
+  /**
+   * @c FnTableCall
+   * @brief The calls of `embed::function_table`. They take the arguments of
+   * the Signature, as `embed::Fn::operator()` does, and pass them to the
+   * stored invokers as `invoke_param_t<ArgsType>`.
+   */
+  /// @c FnTableSweepArg
+  // The argument of one entry in a sweep. A by-value or an rvalue reference
+  // parameter is copied for each entry (so no entry sees a moved-from
+  // object), and an lvalue reference is passed on.
+  template <typename T>
+  using FnTableSweepArg = typename std::conditional<
+    std::is_lvalue_reference<T>::value, T, typename std::remove_reference<T>::type
+  >::type;
+
+  template <typename Derived, typename Signature>
+  struct FnTableCall
+  {
+    static_assert(
+      !std::is_void<FnToolBox::FnTraits::void_t<Signature>>::value /* always false */,
+      "The Signature must be like `Ret(Args...) [const | volatile | & | &&] [noexcept]`."
+      " And your signature format is incorrect.");
+  };
+
+#define EMBED_FN_TABLE_CALL_CODE_IMPL(C, V, REF, NOEXC, NOEXC_B)                          \
+  template <typename Derived, typename RetType, typename... ArgsType>                   \
+  struct FnTableCall<Derived, RetType(ArgsType...) C V REF NOEXC>                       \
+  {                                                                                     \
+    /* Invoke the entry `index` with `args...`. */                                      \
+    EMBED_INLINE RetType invoke(std::size_t index, ArgsType... args)                    \
+    EMBED_FN_CASE_NOEXCEPT_IF(NOEXC_B)                                                  \
+    {                                                                                   \
+      Derived& self = static_cast<Derived&>(*this);                                     \
+      return self.M_invokers[index](self.M_functors[index],                             \
+        std::forward<ArgsType>(args)...);                                               \
+    }                                                                                   \
+    /* Invoke the entries in [first, last) in order. Each entry is passed its own */    \
+    /* copy of a by-value or rvalue reference argument, and the results are */          \
+    /* discarded. */                                                                    \
+    void invoke_range(std::size_t first, std::size_t last, ArgsType... args)            \
+    {                                                                                   \
+      Derived& self = static_cast<Derived&>(*this);                                     \
+      for (std::size_t i = first; i < last; ++i)                                        \
+      {                                                                                 \
+        if (Derived::S_prefetch && i + EMBED_FN_TABLE_PREFETCH < last)                  \
+          EMBED_PREFETCH(&self.M_functors[i + EMBED_FN_TABLE_PREFETCH]);                \
+        self.M_invokers[i](self.M_functors[i],                                          \
+          static_cast<FnTableSweepArg<ArgsType>>(args)...);                             \
+      }                                                                                 \
+    }                                                                                   \
+    /* Invoke all the entries in order, each with `args...`. */                         \
+    void invoke_all(ArgsType... args)                                                   \
+    {                                                                                   \
+      invoke_range(0, static_cast<Derived&>(*this).M_size,                              \
+        std::forward<ArgsType>(args)...);                                               \
+    }                                                                                   \
+  };
+
+#define EMBED_FN_TABLE_CALL_CODE(C, V, REF)                   \
+  EMBED_FN_TABLE_CALL_CODE_IMPL(C, V, REF, , false)
+
+  // Specialize the `FnTableCall` with different modifiers.
+  EMBED_FN_GENERATE_CODE_C_V_REF(EMBED_FN_TABLE_CALL_CODE)
+
+#if EMBED_CXX_VERSION >= 201703L
+# undef EMBED_FN_TABLE_CALL_CODE
+# define EMBED_FN_TABLE_CALL_CODE(C, V, REF)                  \
+  EMBED_FN_TABLE_CALL_CODE_IMPL(C, V, REF, noexcept, true)
+
+  // Overload for the noexcept Signature. (Since C++17)
+  EMBED_FN_GENERATE_CODE_C_V_REF(EMBED_FN_TABLE_CALL_CODE)
+#endif
+
+#undef EMBED_FN_TABLE_CALL_CODE
+#undef EMBED_FN_TABLE_CALL_CODE_IMPL
+
+} // end namespace embed::detail
+
+  /**
+   * @brief `embed::function_table<Signature, BufSize, Capacity>` holds up to
+   * `Capacity` callbacks of `embed::function<Signature, BufSize>` in a
+   * structure-of-arrays layout: the invokers, the buffers and the managers
+   * are kept in three separate arrays.
+   * 
+   * A sweep (`invoke_all` / `invoke_range`) only reads the invoker and the
+   * buffer of each entry, both in order, and can prefetch the buffer
+   * `EMBED_FN_TABLE_PREFETCH` entries ahead. The managers are only read
+   * to relocate or destroy a target. An array of embed::Fn interleaves
+   * them, and the compact layout loads the invoker from the manager table
+   * on every call.
+   * 
+   * An empty embed::Fn is not added, so every entry is callable. Erasure
+   * moves the last entry into the hole (the order is not kept).
+   */
+  template <typename Signature, std::size_t BufSize, std::size_t Capacity>
+  class function_table
+  : public detail::FnTableCall<function_table<Signature, BufSize, Capacity>, Signature>
+  {
+  public:
+    using function_type = function<Signature, BufSize>;
+    using result_type = typename function_type::result_type;
+
+  private:
+    static_assert(Capacity > 0, "embed::function_table requires 0 < Capacity");
+
+    using Invoker_Type = typename function_type::Invoker_Type;
+    using Manager_Type = typename function_type::Manager_Type;
+    using Functor_Type = detail::FnFunctor<function_type::buffer_size, detail::FnDefaultAlign>;
+
+    // The calls read the arrays.
+    template <typename, typename>
+    friend struct detail::FnTableCall;
+
+    Invoker_Type  M_invokers[Capacity]; // Read by every call
+    Functor_Type  M_functors[Capacity]; // Read by every call
+    Manager_Type  M_managers[Capacity]; // Read by relocation / destruction
+    std::size_t   M_size;
+
+    // A table not longer than the prefetch distance is not prefetched.
+    static constexpr bool S_prefetch =
+      EMBED_FN_TABLE_PREFETCH > 0 && Capacity > EMBED_FN_TABLE_PREFETCH;
+
+    // Destroy the target of the entry `index`.
+    EMBED_INLINE void M_destroy(std::size_t index) noexcept
+    {
+      if (!M_managers[index]->M_trivial)
+        M_managers[index]->M_destroy(M_functors[index]);
+    }
+
+    // Relocate the entry `src` into the entry `dest`. (`dest` MUST be destroyed)
+    EMBED_INLINE void M_move(std::size_t dest, std::size_t src) noexcept
+    {
+      function_type::M_relocate(M_managers[src], M_functors[dest], M_functors[src]);
+      M_invokers[dest] = M_invokers[src];
+      M_managers[dest] = M_managers[src];
+    }
+
+  public:
+    // Create an empty table.
+    function_table() noexcept : M_size(0) {}
+
+    function_table(const function_table&) = delete;
+    function_table& operator=(const function_table&) = delete;
+
+    ~function_table() noexcept { clear(); }
+
+    /**
+     * @brief Append the target of `fn`, which is relocated into the table.
+     * @return `false` if the table is full or `fn` is empty.
+     */
+    bool push_back(function_type fn) noexcept
+    {
+      if EMBED_UNLIKELY(M_size == Capacity || !fn)
+        return false;
+
+      function_type::M_relocate(fn.M_manager, M_functors[M_size], fn.M_functor);
+      M_invokers[M_size] = fn.M_get_invoker();
+      M_managers[M_size] = fn.M_manager;
+      fn.M_set_empty();
+      ++M_size;
+      return true;
+    }
+
+    // Remove the last entry. The table MUST NOT be empty.
+    void pop_back() noexcept
+    {
+      M_destroy(--M_size);
+    }
+
+    // Remove the entry `index`, the last entry is moved into its place.
+    void erase(std::size_t index) noexcept
+    {
+      M_destroy(index);
+      if (index != --M_size)
+        M_move(index, M_size);
+    }
+
+    // Remove all the entries.
+    void clear() noexcept
+    {
+      while (M_size != 0)
+        pop_back();
+    }
+
+    // The number of entries.
+    EMBED_NODISCARD std::size_t size() const noexcept
+    { return M_size; }
+
+    // The maximum number of entries.
+    EMBED_NODISCARD static constexpr std::size_t capacity() noexcept
+    { return Capacity; }
+
+    // `true` if there is no entry.
+    EMBED_NODISCARD bool empty() const noexcept
+    { return M_size == 0; }
+  };
+
+#if EMBED_CXX_VERSION >= 201703L
+
+  /**
+   * @brief `embed::nontype_t<&func>` binds a free function at compile time.
+   * The tag is an empty object, so `embed::Fn` constructed from it stores
+   * nothing and its invoker calls `func` directly instead of loading a
+   * function pointer from the buffer. (Since C++17)
+   */
+  template <auto Func>
+  struct nontype_t
+  {
+    static_assert(std::is_pointer<decltype(Func)>::value
+      && std::is_function<typename std::remove_pointer<decltype(Func)>::type>::value,
+      "embed::nontype_t requires a pointer to free function");
+
+    constexpr nontype_t() noexcept = default;
+
+    template <typename... ArgsType>
+    EMBED_INLINE constexpr decltype(auto) operator() (ArgsType&&... args) const
+    noexcept(noexcept(Func(std::forward<ArgsType>(args)...)))
+    { return Func(std::forward<ArgsType>(args)...); }
+  };
+
+  /// @brief Tag object for the constructor, e.g. `embed::function<void()> fn(embed::nontype<&func>)`.
+  template <auto Func>
+  inline constexpr nontype_t<Func> nontype{};
+
+namespace detail {
+
+  /**
+   * @c FnDelegate
+   * @brief The object pointer and the call of `embed::delegate<&Class::method>`.
+   * The member function is a template argument, so only `this` is stored.
+   */
+  template <auto Method, typename = decltype(Method)>
+  struct FnDelegate
+  {
+    static_assert(std::is_member_function_pointer<decltype(Method)>::value,
+      "embed::delegate requires a pointer to non-static member function");
+  };
+
+#define EMBED_FN_DELEGATE_CODE_IMPL(C, V, REF, NOEXC)\
+  template <auto Method, typename RetType, typename Class, typename... ArgsType>\
+  struct FnDelegate<Method, RetType (Class::*) (ArgsType...) C V REF NOEXC>\
+  {\
+    using Object_Type = C V Class;\
+    using Signature = RetType(ArgsType...) const NOEXC;\
+    Object_Type* M_object;\
+    EMBED_INLINE constexpr RetType operator() (ArgsType... args) const NOEXC\
+    {\
+      return (std::forward<C V Class REF>(*M_object).*Method)(\
+        std::forward<ArgsType>(args)...);\
+    }\
+  };
+
+#define EMBED_FN_DELEGATE_CODE(C, V, REF)\
+  EMBED_FN_DELEGATE_CODE_IMPL(C, V, REF, )
+
+  // Specialize the `FnDelegate` with different modifiers.
+  // (const / volatile / {& | &&})
+  EMBED_FN_GENERATE_CODE_C_V_REF(EMBED_FN_DELEGATE_CODE)
+
+#undef EMBED_FN_DELEGATE_CODE
+#define EMBED_FN_DELEGATE_CODE(C, V, REF)\
+  EMBED_FN_DELEGATE_CODE_IMPL(C, V, REF, noexcept)
+
+  // Specialize the `FnDelegate` with different modifiers.
+  // (const / volatile / {& | &&} + noexcept)
+  EMBED_FN_GENERATE_CODE_C_V_REF(EMBED_FN_DELEGATE_CODE)
+
+#undef EMBED_FN_DELEGATE_CODE
+#undef EMBED_FN_DELEGATE_CODE_IMPL
+
+} // end namespace embed::detail
+
+  /**
+   * @brief `embed::delegate<&Class::method>(obj)` binds a member function
+   * and an object. Only the pointer to `obj` is stored (one word, trivially
+   * copyable), and the call is generated from the member pointer at compile
+   * time, so `embed::Fn` constructed from it calls `method` directly.
+   * The object must outlive the delegate. (Since C++17)
+   */
+  template <auto Method>
+  class delegate
+  : public detail::FnDelegate<Method>
+  {
+  private:
+    using MyDelegate = detail::FnDelegate<Method>;
+
+  public:
+    // The object type, with the cv-qualifiers of the member function.
+    using object_type = typename MyDelegate::Object_Type;
+
+    // The signature of `operator()`.
+    using signature_type = typename MyDelegate::Signature;
+
+    // Bind `obj` to the member function.
+    EMBED_INLINE explicit constexpr delegate(object_type& obj) noexcept
+    : MyDelegate{std::addressof(obj)} {}
+
+    // A temporary object cannot be bound.
+    delegate(object_type&&) = delete;
+  };
+
+#endif
+
+  template <typename Functor, typename Count>
+  class shared_target;
+
+  /**
+   * @brief `embed::shared_block<Functor>` is caller-supplied storage for one
+   * target that is too large for the buffer of `embed::Fn`. The target lives
+   * once in the block, and `embed::Fn` stores an `embed::shared_target`
+   * handle (one pointer) instead. Copying the handle increments the count of
+   * the block, and when the last handle is destroyed the target is destroyed
+   * and the block can be reused by `emplace` again.
+   * 
+   * All the handles share one target (like a pointer), a call through any
+   * copy can observe the state changed by another. `Count` may be replaced
+   * with `std::atomic<std::size_t>` if the handles are copied or destroyed
+   * concurrently. The block must outlive all of its handles.
+   */
+  template <typename Functor, typename Count = std::size_t>
+  class shared_block
+  {
+  private:
+    friend class shared_target<Functor, Count>;
+
+    detail::FnFunctor<sizeof(Functor), alignof(Functor)> M_storage;
+    Count                                              M_count;
+
+    /// @e M_acquire
+    EMBED_INLINE void M_acquire() noexcept
+    { ++M_count; }
+
+    /// @e M_release
+    // Destroy the target when the last handle is released.
+    EMBED_INLINE void M_release() noexcept
+    {
+      if (--M_count == 0)
+        M_storage.template M_access<Functor>().~Functor();
+    }
+
+  public:
+    using target_type = Functor;
+
+    // Construct an empty block.
+    shared_block() noexcept : M_storage(), M_count(0) {}
+
+    shared_block(const shared_block&) = delete;
+    shared_block& operator=(const shared_block&) = delete;
+
+    // Construct the target in the block and return the first handle.
+    // @pre use_count() == 0, otherwise `throw_bad_function_call_or_abort()`.
+    // (The alive target is never overwritten)
+    template <typename... Args>
+    EMBED_NODISCARD shared_target<Functor, Count> emplace(Args&&... args)
+    noexcept(std::is_nothrow_constructible<Functor, Args...>::value)
+    {
+      if EMBED_UNLIKELY(use_count() != 0)
+        detail::throw_bad_function_call_or_abort(); /* may not throw exception */
+      ::new (M_storage.M_access()) Functor(std::forward<Args>(args)...);
+      return shared_target<Functor, Count>(*this);
+    }
+
+    // Return another handle to the alive target.
+    // @pre use_count() != 0, otherwise `throw_bad_function_call_or_abort()`.
+    EMBED_NODISCARD shared_target<Functor, Count> share() noexcept
+    {
+      if EMBED_UNLIKELY(use_count() == 0)
+        detail::throw_bad_function_call_or_abort(); /* may not throw exception */
+      return shared_target<Functor, Count>(*this);
+    }
+
+    // The number of handles referring to the target (0 if empty).
+    EMBED_NODISCARD std::size_t use_count() const noexcept
+    { return static_cast<std::size_t>(M_count); }
+  };
+
+  /**
+   * @brief `embed::shared_target<Functor>` is the handle created by
+   * `embed::shared_block<Functor>`. It is one pointer in size, so it fits
+   * in the smallest `embed::Fn`, and it forwards the call to the shared target.
+   */
+  template <typename Functor, typename Count = std::size_t>
+  class shared_target
+  {
+  private:
+    friend class shared_block<Functor, Count>;
+
+    shared_block<Functor, Count>* M_block;
+
+    EMBED_INLINE explicit shared_target(shared_block<Functor, Count>& block) noexcept
+    : M_block(std::addressof(block))
+    { M_block->M_acquire(); }
+
+  public:
+    shared_target(const shared_target& other) noexcept
+    : M_block(other.M_block)
+    {
+      if (M_block != nullptr)
+        M_block->M_acquire();
+    }
+
+    shared_target(shared_target&& other) noexcept
+    : M_block(other.M_block)
+    { other.M_block = nullptr; }
+
+    shared_target& operator=(shared_target other) noexcept
+    {
+      shared_block<Functor, Count>* tmp = M_block;
+      M_block = other.M_block;
+      other.M_block = tmp;
+      return *this;
+    }
+
+    ~shared_target()
+    {
+      if (M_block != nullptr)
+        M_block->M_release();
+    }
+
+    // Call the shared target.
+    template <typename... Args>
+    EMBED_INLINE auto operator() (Args&&... args) const
+    noexcept(noexcept(std::declval<Functor&>()(std::declval<Args>()...)))
+    -> decltype(std::declval<Functor&>()(std::declval<Args>()...))
+    {
+      return M_block->M_storage.template M_access<Functor>()(
+        std::forward<Args>(args)...);
+    }
+  };
+
+namespace detail {
+
+  /**
+   * @c FnStatelessObject
+   * @brief The object kept for a stateless `Functor` that cannot be built
+   * from nothing (e.g. a captureless lambda before C++20). The storage is
+   * constant-initialized, so reading it needs no guard of a local static.
+   */
+  template <typename Functor>
+  struct FnStatelessObject
+  {
+    union Storage
+    {
+      char    M_unused;
+      Functor M_object;
+
+      constexpr Storage() noexcept : M_unused() {}
+    };
+
+    static Storage S_storage;
+  };
+
+  template <typename Functor>
+  typename FnStatelessObject<Functor>::Storage FnStatelessObject<Functor>::S_storage;
+
+  /**
+   * @c FnStateless
+   * @brief The storage and invocation of `embed::stateless_function`.
+   * Only the invoker is stored. The target is empty and trivially
+   * copyable, so every object of its class has the same (no) value.
+   */
+  template <typename PureSignature, bool Is_noexcept,
+    bool Is_const = false, bool Is_volatile = false, bool Is_rref = false>
+  class FnStateless;
+
+  template <typename RetType, bool Is_noexcept,
+    bool Is_const, bool Is_volatile, bool Is_rref, typename... ArgsType>
+  class FnStateless<RetType(ArgsType...), Is_noexcept, Is_const, Is_volatile, Is_rref>
+  : private FnToolBox
+  {
+  protected:
+    using Invoker_Type = RetType (*)
+      (FnTraits::invoke_param_t<ArgsType>...) EMBED_FN_CASE_NOEXCEPT_IF(Is_noexcept);
+
+    // The target, qualified as the Signature.
+    template <typename Functor>
+    using Qualified_CV = typename std::conditional<Is_volatile,
+      typename std::conditional<Is_const, const volatile Functor, volatile Functor>::type,
+      typename std::conditional<Is_const, const Functor, Functor>::type
+    >::type;
+    template <typename Functor>
+    using Qualified = typename std::conditional<Is_rref,
+      Qualified_CV<Functor>&&, Qualified_CV<Functor>&>::type;
+
+    template <typename Functor>
+    using Callable = FnTraits::Callable<RetType, Qualified<Functor>, ArgsType...>;
+
+    /// @e M_prepare
+    template <typename Functor>
+    static void M_prepare(const Functor& func) noexcept
+    {
+      M_prepare_impl(std::is_trivially_constructible<Functor>{}, func);
+    }
+
+    template <typename Functor>
+    static void M_prepare_impl(std::true_type, const Functor&) noexcept {}
+
+    // The constructor of embed::stateless_function copies its argument
+    // into `FnStatelessObject`, before any call. (Every copy is the same)
+    template <typename Functor>
+    static void M_prepare_impl(std::false_type, const Functor& func) noexcept
+    {
+      ::new (std::addressof(FnStatelessObject<Functor>::S_storage.M_object)) Functor(func);
+    }
+
+    /// @e M_invoke
+    // Call a fresh object of `Functor`, or the kept one if it cannot be
+    // default constructed.
+    template <typename Functor>
+    static RetType M_invoke(FnTraits::invoke_param_t<ArgsType>... args)
+    EMBED_FN_CASE_NOEXCEPT_IF(Is_noexcept)
+    {
+      return M_invoke_impl<Functor>(std::is_trivially_constructible<Functor>{},
+        std::forward<ArgsType>(args)...);
+    }
+
+    template <typename Functor>
+    static EMBED_INLINE RetType M_invoke_impl(std::true_type,
+      FnTraits::invoke_param_t<ArgsType>... args)
+    EMBED_FN_CASE_NOEXCEPT_IF(Is_noexcept)
+    {
+      Functor object{};
+      return FnTraits::invoke_r<RetType>(
+        static_cast<Qualified<Functor>>(object),
+        std::forward<ArgsType>(args)...);
     }
 
-    /// @brief Overload the function specifically for the case where nullptr is
-    /// passed as a parameter, in order to improve the program's running efficiency. 
-    /// (Using the `swap` method would be much slower.)
-    EMBED_INLINE Fn& operator=(std::nullptr_t) noexcept
+    template <typename Functor>
+    static EMBED_INLINE RetType M_invoke_impl(std::false_type,
+      FnTraits::invoke_param_t<ArgsType>... args)
+    EMBED_FN_CASE_NOEXCEPT_IF(Is_noexcept)
     {
-      if (M_manager)
-      {
-        M_manager(M_functor, M_functor, OP_destroy_functor);
-        M_manager = nullptr;
-        M_invoker = nullptr;
-      }
-      return *this;
+      return FnTraits::invoke_r<RetType>(
+        static_cast<Qualified<Functor>>(FnStatelessObject<Functor>::S_storage.M_object),
+        std::forward<ArgsType>(args)...);
     }
 
-    /// @brief Overload the move assign to enhance the performance.
-    Fn& operator=(Fn&& fn) noexcept
+#if ( EMBED_FN_EMPTY_SENTINEL == true )
+    /// @e M_invoke_empty
+    // Call an empty embed::stateless_function.
+    [[noreturn]] static RetType M_invoke_empty(FnTraits::invoke_param_t<ArgsType>...)
+    EMBED_FN_CASE_NOEXCEPT_IF(Is_noexcept)
     {
-      if (M_manager != nullptr) {
-        M_manager(M_functor, M_functor, OP_destroy_functor);
-        M_manager = nullptr;
-        M_invoker = nullptr;
-      }
-      if (static_cast<bool>(fn)) {
-        fn.M_manager(M_functor, fn.M_functor, OP_move_functor);
-        M_manager = fn.M_manager;
-        M_invoker = fn.M_invoker;
-        fn.M_manager = nullptr;
-        fn.M_invoker = nullptr;
-      }
-      return *this;
+      throw_bad_function_call_or_abort(); /* may not throw exception */
     }
 
+    static constexpr Invoker_Type M_empty_invoker() noexcept
+    { return &M_invoke_empty; }
 #else
+    static constexpr Invoker_Type M_empty_invoker() noexcept
+    { return nullptr; }
+#endif
 
-    // Copy constructor for embed::Fn.
-    // Use `placement new` to create new functor,
-    // which will call functor's copy-constructor.
-    Fn(const Fn& fn) noexcept
-    {
-      if (static_cast<bool>(fn))
-      {
-        fn.M_manager(M_functor, fn.M_functor, OP_clone_functor);
-        M_manager = fn.M_manager;
-      }
-    }
+    Invoker_Type M_invoker{M_empty_invoker()};
 
-    // Move constructor for embed::Fn.
-    // Use `placement new` to create new functor,
-    // which will call functor's move-constructor.
-    Fn(Fn&& fn) noexcept
+  public:
+    EMBED_INLINE RetType operator() (ArgsType... args) const
+    EMBED_FN_CASE_NOEXCEPT_IF(Is_noexcept)
     {
-      if (static_cast<bool>(fn))
-      {
-        fn.M_manager(M_functor, fn.M_functor, OP_move_functor);
-        M_manager = fn.M_manager;
-        fn.M_manager = nullptr;
-      }
+#if ( EMBED_FN_EMPTY_SENTINEL == true )
+      return M_invoker(std::forward<ArgsType>(args)...);
+#else
+      if EMBED_LIKELY(M_invoker)
+        return M_invoker(std::forward<ArgsType>(args)...);
+      else
+        detail::throw_bad_function_call_or_abort(); /* may not throw exception */
+#endif
     }
+  };
 
-    // Construct Fn<Sig_A> with Fn<Sig_B>
-    // restrictions: `Sig_B.ret` can convert to `Sig_A.ret`
-    // `Sig_A.args` are same with `Sig_B.args`.
-    template <typename OtherSignature, std::size_t OtherSize>
-    Fn(
-      const Fn<OtherSignature, OtherSize>& fn,
-      typename std::enable_if<FnTraits::is_Fn_and_similar<
-        Signature, Fn<OtherSignature, OtherSize>
-      >::value, bool>::type = true
-    ) noexcept {
-      if (static_cast<bool>(fn))
-      {
-        fn.M_manager(
-          *reinterpret_cast<detail::FnFunctor<OtherSize>*>(&M_functor),
-          fn.M_functor, OP_clone_functor
-        );
-        M_manager = reinterpret_cast<Manager_Type>(fn.M_manager);
-      }
-    }
+} // end namespace embed::detail
 
-    /**
-     * @brief Builds a Fn that targets a copy of the incoming
-     * function object.
-     * @param func - A callable object with parameters of type
-     * `ArgsType...` and returns a value convertible to `RetType`.
-     * 
-     * REQUIRE:
-     * 1. `decltype(func)` must be Callable.
-     * 2. `std::decay<decltype(func)>::type` must be nothrow copy constructible.
-     * 3. `std::decay<decltype(func)>::type` must be nothrow constructible from
-     * the type `decltype(func)` object.
-     */
-    template <typename Functor,
-      typename DecayFunctor = Fn::DecayFunc_t<Functor>,
-      typename = typename std::enable_if<!FnTraits::is_Fn_and_similar<
-        Signature, FnTraits::remove_cvref_t<Functor>
-      >::value>::type,
-      typename = FnTraits::disableIf_movable_and_non_copyable_and_nref_t<Functor> >
-    Fn(Functor&& func) noexcept
-    {
-      static_assert(Fn::Callable<Functor>::value,
-        "embed::Fn requires the Functor is callable and the Signature match RetType");
+  /**
+   * @brief   `embed::stateless_function` only stores the invoker, one pointer
+   * in total. It accepts empty and trivially copyable class types only, e.g.
+   * captureless lambdas, empty functors and `embed::nontype<&func>`.
+   * @note    The target is called with the qualifiers of the `Signature`
+   * (e.g. as a const rvalue for `Ret(Args...) const &&`), like embed::Fn.
+   */
+  template <typename Signature>
+  class stateless_function
+  : public detail::FnStateless<
+      typename detail::FnToolBox::FnTraits::unwrap_signature<Signature>::pure_sig,
+      detail::FnToolBox::FnTraits::get_signature_qualifier<Signature>::is_noexcept,
+      detail::FnToolBox::FnTraits::get_signature_qualifier<Signature>::is_const,
+      detail::FnToolBox::FnTraits::get_signature_qualifier<Signature>::is_volatile,
+      detail::FnToolBox::FnTraits::get_signature_qualifier<Signature>::is_rref>
+  {
+  private:
+    using FnTraits = detail::FnToolBox::FnTraits;
 
-      static_assert(std::is_copy_constructible<DecayFunctor>::value,
-        "embed::Fn target must be copy-constructible");
+    using MyStateless = detail::FnStateless<
+      typename FnTraits::unwrap_signature<Signature>::pure_sig,
+      FnTraits::get_signature_qualifier<Signature>::is_noexcept,
+      FnTraits::get_signature_qualifier<Signature>::is_const,
+      FnTraits::get_signature_qualifier<Signature>::is_volatile,
+      FnTraits::get_signature_qualifier<Signature>::is_rref>;
 
-      static_assert(std::is_nothrow_constructible<DecayFunctor, Functor>::value,
-        "embed::Fn target must be NO-THROW constructible from the "
-        "constructor argument");
+    template <typename Functor>
+    using DecayFunc_t = typename std::enable_if<
+      !std::is_same<stateless_function, FnTraits::remove_cvref_t<Functor> >::value,
+      typename std::decay<Functor>::type
+    >::type;
 
-      static_assert(
-        !(FnTraits::get_signature_qualifier<Signature>::is_const 
-          && FnTraits::is_class_and_has_call_operator<
-            typename FnTraits::unwrap_signature<Signature>::pure_sig,
-            Functor>::not_const_q),
-        "embed::Fn requires the signature is non-const-qualified because the"
-        " Functor::operator() is not const-qualified"
-      );
+    using MyStateless::M_invoker;
+    using MyStateless::M_empty_invoker;
 
-      if (Fn::MyManager<DecayFunctor>::M_not_empty_function(func))
-      {
-        Fn::MyManager<DecayFunctor>::M_init_functor(M_functor, std::forward<Functor>(func));
+  public:
+    using result_type = typename FnTraits::unwrap_signature<Signature>::ret;
 
-        // To suppress the warnings of Arduino Uno, a forced type conversion is added here.
-        static_assert(
-          std::is_same<Manager_Type, decltype(&Fn::MyManager<DecayFunctor>::M_manager)>::value,
-          "The library ensures that the types of the two are consistent."
-        );
-        M_manager = reinterpret_cast<Manager_Type>(&Fn::MyManager<DecayFunctor>::M_manager);
-      }
-    }
+    // Create an empty function wrapper.
+    EMBED_INLINE constexpr stateless_function() noexcept = default;
+
+    // Create an empty function wrapper.
+    EMBED_INLINE constexpr stateless_function(std::nullptr_t) noexcept {}
 
-# if !defined(EMBED_NO_NONCOPYABLE_FUNCTOR)
     /**
-     * @brief Constructor for non-copyable object.
-     * @attention embed::Fn instance constructed from non-copyable object
-     * CANNOT use any copy behaviour, otherwise `std::terminate` will be called.
+     * @brief Constructor for the stateless callable object.
+     * 1. `decltype(func)` must be Callable.
+     * 2. `std::decay<decltype(func)>::type` must be an empty class.
+     * 3. `std::decay<decltype(func)>::type` must be trivially copyable.
      */
     template <typename Functor,
-      typename DecayFunctor = Fn::DecayFunc_t<Functor>,
-      typename = FnTraits::enableIf_movable_and_non_copyable_t<DecayFunctor>,
-      typename = typename std::enable_if<!FnTraits::is_Fn_and_similar<
-        Signature, FnTraits::remove_cvref_t<Functor>
-      >::value>::type,
-      typename = typename std::enable_if<!std::is_reference<Functor>::value>::type >
-    Fn(Functor&& func)
+      typename DecayFunctor = DecayFunc_t<Functor> >
+    stateless_function(Functor&& func) noexcept
     {
-      static_assert(Fn::Callable<Functor>::value,
-        "embed::Fn requires the Functor is callable and the Signature match RetType");
-
-      static_assert(
-        !(FnTraits::get_signature_qualifier<Signature>::is_const 
-          && FnTraits::is_class_and_has_call_operator<
-            typename FnTraits::unwrap_signature<Signature>::pure_sig,
-            Functor>::not_const_q),
-        "embed::Fn requires the signature is non-const-qualified because the"
-        " Functor::operator() is not const-qualified"
-      );
-
-      if (Fn::MyMoveOnly<DecayFunctor>::M_not_empty_function(func))
-      {
-        Fn::MyMoveOnly<DecayFunctor>::M_init_functor(M_functor, std::move(func));
-
-        // To suppress the warnings of Arduino Uno, a forced type conversion is added here.
-        static_assert(
-          std::is_same<Manager_Type, decltype(&Fn::MyMoveOnly<DecayFunctor>::M_manager)>::value,
-          "The library ensures that the types of the two are consistent."
-        );
-        M_manager = reinterpret_cast<Manager_Type>(&Fn::MyMoveOnly<DecayFunctor>::M_manager);
-      }
-    }
-# endif // !defined(EMBED_NO_NONCOPYABLE_FUNCTOR)
+      static_assert(MyStateless::template Callable<DecayFunctor>::value,
+        "embed::stateless_function requires the Functor is callable and"
+        " the Signature match RetType");
 
-    // Swap Fn but unknown the real type of `Functor`.
-    // But only M_manager remember the `Functor`.
-    void swap(Fn& fn) noexcept
-    {
-      detail::FnFunctor<BufSize> tmpFunc{};
-      if (M_manager)
-      {
-        M_manager(tmpFunc, M_functor, OP_move_functor);
-        M_manager(M_functor, M_functor, OP_destroy_functor);
-      }
-      if (static_cast<bool>(fn))
-      {
-        fn.M_manager(M_functor, fn.M_functor, OP_move_functor);
-        fn.M_manager(fn.M_functor, fn.M_functor, OP_destroy_functor);
-      }
-      if (M_manager)
-      {
-        M_manager(fn.M_functor, tmpFunc, OP_move_functor);
-        M_manager(tmpFunc, tmpFunc, OP_destroy_functor);
-      }
-      std::swap(M_manager, fn.M_manager);
-    }
+      static_assert(std::is_empty<DecayFunctor>::value,
+        "embed::stateless_function target must be an empty class"
+        " (use embed::function for stateful targets)");
 
-    /// @brief Overload the function specifically for the case where nullptr is
-    /// passed as a parameter, in order to improve the program's running efficiency. 
-    /// (Using the `swap` method would be much slower.)
-    EMBED_INLINE Fn& operator=(std::nullptr_t) noexcept
-    {
-      if (M_manager)
-      {
-        M_manager(M_functor, M_functor, OP_destroy_functor);
-        M_manager = nullptr;
-      }
-      return *this;
-    }
+      static_assert(std::is_trivially_copyable<DecayFunctor>::value,
+        "embed::stateless_function target must be trivially copyable");
 
-    /// @brief Overload the move assign to enhance the performance.
-    Fn& operator=(Fn&& fn) noexcept
-    {
-      if (M_manager != nullptr) {
-        M_manager(M_functor, M_functor, OP_destroy_functor);
-        M_manager = nullptr;
-      }
-      if (static_cast<bool>(fn)) {
-        fn.M_manager(M_functor, fn.M_functor, OP_move_functor);
-        M_manager = fn.M_manager;
-        fn.M_manager = nullptr;
-      }
-      return *this;
+      MyStateless::template M_prepare<DecayFunctor>(func);
+      M_invoker = &MyStateless::template M_invoke<DecayFunctor>;
     }
 
-#endif // End EMBED_FN_NEED_FAST_CALL == true or not
-
-    /// @attention operator= may consume more resource,
-    /// maybe copy/move constructor is better.
-    EMBED_INLINE Fn& operator=(const Fn& fn) noexcept
+    // Reset to empty.
+    EMBED_INLINE stateless_function& operator=(std::nullptr_t) noexcept
     {
-      if (this != std::addressof(fn))
-        Fn(fn).swap(*this);
+      M_invoker = M_empty_invoker();
       return *this;
     }
 
-    /// @attention operator= may consume more resource,
-    /// maybe copy/move constructor is better.
-    template <typename OtherSignature, std::size_t OtherSize,
-      typename = typename std::enable_if<FnTraits::is_Fn_and_similar<
-        Signature, Fn<OtherSignature, OtherSize>
-      >::value>::type>
-    EMBED_INLINE Fn& operator=(const Fn<OtherSignature, OtherSize>& fn) noexcept 
+    // Replace the target.
+    template <typename Functor,
+      typename = DecayFunc_t<Functor> >
+    EMBED_INLINE stateless_function& operator=(Functor&& func) noexcept
     {
-      Fn(fn).swap(*this);
-      return *this;
+      return *this = stateless_function(std::forward<Functor>(func));
     }
 
-    /// @attention operator= may consume more resource,
-    /// maybe copy/move constructor is better.
-    template <typename Functor,
-      typename DecayFunc = Fn::DecayFunc_t<Functor>,
-      typename = typename std::enable_if<!FnTraits::is_Fn_and_similar<
-        Signature, FnTraits::remove_cvref_t<Functor>
-      >::value>::type>
-    EMBED_INLINE Fn& operator=(Functor&& func) noexcept
+    // Swap the targets.
+    EMBED_INLINE void swap(stateless_function& fn) noexcept
     {
-      Fn(std::forward<Functor>(func)).swap(*this);
-      return *this;
+      typename MyStateless::Invoker_Type tmp = M_invoker;
+      M_invoker = fn.M_invoker;
+      fn.M_invoker = tmp;
     }
 
-    // check if the embed::Fn is empty.
+    // Check if it is empty.
     EMBED_INLINE constexpr bool is_empty() const noexcept
     {
-      return static_cast<bool>( M_manager == nullptr );
+      return M_invoker == M_empty_invoker();
     }
 
-    // `true` if the embed::Fn is not empty.
+    // Check if it is not empty.
     EMBED_INLINE constexpr explicit operator bool() const noexcept
     {
       return !is_empty();
     }
-
-
-  }; // end Fn
-
+  };
 
   // `true` if the wrapper has no target, `false` otherwise. (noexcept)
-  template <typename Signature, std::size_t BufSize>
+  template <typename Signature>
   static EMBED_INLINE constexpr bool
-  operator==(const Fn<Signature, BufSize>& fn, std::nullptr_t) noexcept
+  operator==(const stateless_function<Signature>& fn, std::nullptr_t) noexcept
   { return fn.is_empty(); }
 
   // `true` if the wrapper has no target, `false` otherwise. (noexcept)
-  template <typename Signature, std::size_t BufSize>
+  template <typename Signature>
   static EMBED_INLINE constexpr bool
-  operator==(std::nullptr_t, const Fn<Signature, BufSize>& fn) noexcept
+  operator==(std::nullptr_t, const stateless_function<Signature>& fn) noexcept
   { return fn.is_empty(); }
 
   // `true` if the wrapper does have target, `false` otherwise. (noexcept)
-  template <typename Signature, std::size_t BufSize>
+  template <typename Signature>
   static EMBED_INLINE constexpr bool
-  operator!=(const Fn<Signature, BufSize>& fn, std::nullptr_t) noexcept
+  operator!=(const stateless_function<Signature>& fn, std::nullptr_t) noexcept
   { return !fn.is_empty(); }
 
   // `true` if the wrapper does have target, `false` otherwise. (noexcept)
-  template <typename Signature, std::size_t BufSize>
+  template <typename Signature>
   static EMBED_INLINE constexpr bool
-  operator!=(std::nullptr_t, const Fn<Signature, BufSize>& fn) noexcept
+  operator!=(std::nullptr_t, const stateless_function<Signature>& fn) noexcept
   { return !fn.is_empty(); }
 
+namespace detail {
+
   /**
-   * @brief `embed::function` is an alias of `embed::Fn`.
-   * @note It is encouraged to use `embed::function` instead of `embed::Fn`.
-   * `embed::function` will automatically align the BufSize.
+   * @c FnRefObject
+   * @brief What an `embed::function_ref` refers to: the address of
+   * a callable object, or a free function (a function pointer cannot
+   * be converted to `void*` portably).
    */
-  template <typename Signature, std::size_t BufSize = detail::FnDefaultBufSize>
-  using function = Fn<Signature, detail::FnToolBox::FnTraits::aligned_buf_size<BufSize>::value>;
+  union FnRefObject
+  {
+    void* M_object;
+    void (*M_function) ();
+  };
+
+  /**
+   * @c FnRefHelper
+   * @brief The storage and invocation of `embed::function_ref`. The
+   * qualifiers of the Signature decide how the referred object is
+   * invoked: as `[const] [volatile] Functor&` or as `... Functor&&`.
+   */
+  template <typename Signature>
+  class FnRefHelper
+  {
+    static_assert(
+      !std::is_void<FnToolBox::FnTraits::void_t<Signature>>::value /* always false */,
+      "The Signature must be like `Ret(Args...) [const | volatile | & | &&] [noexcept]`."
+    );
+  };
+
+#define EMBED_FN_REF_HELPER_CODE_IMPL(C, V, REF, NOEXC, NOEXC_B)                          \
+  template <typename RetType, typename... ArgsType>                                       \
+  class FnRefHelper<RetType(ArgsType...) C V REF NOEXC>                                   \
+  : private FnToolBox                                                                     \
+  {                                                                                       \
+  protected:                                                                              \
+    using Thunk_Type = RetType (*) (FnRefObject,                                          \
+      FnTraits::invoke_param_t<ArgsType>...) EMBED_FN_CASE_NOEXCEPT_IF(NOEXC_B);          \
+    template <typename Functor>                                                           \
+    using Qualified = typename std::conditional<                                          \
+      std::is_rvalue_reference<int REF>::value, C V Functor&&, C V Functor&>::type;       \
+    template <typename Functor>                                                           \
+    using Callable = FnTraits::Callable<RetType, Qualified<Functor>, ArgsType...>;        \
+    template <typename Functor>                                                           \
+    static RetType M_invoke_object(FnRefObject obj,                                       \
+      FnTraits::invoke_param_t<ArgsType>... args) EMBED_FN_CASE_NOEXCEPT_IF(NOEXC_B)      \
+    {                                                                                     \
+      static_assert(!NOEXC_B || noexcept(FnTraits::invoke_r<RetType>(                     \
+          std::declval<Qualified<Functor>>(), std::declval<ArgsType>()...)),              \
+        "embed::function_ref with a noexcept Signature requires the functor to be"        \
+        " no-throw callable");                                                            \
+      return FnTraits::invoke_r<RetType>(                                                 \
+        static_cast<Qualified<Functor>>(*static_cast<Functor*>(obj.M_object)),           \
+        std::forward<ArgsType>(args)...);                                                 \
+    }                                                                                     \
+    template <typename FuncPtr>                                                           \
+    static RetType M_invoke_function(FnRefObject obj,                                     \
+      FnTraits::invoke_param_t<ArgsType>... args) EMBED_FN_CASE_NOEXCEPT_IF(NOEXC_B)      \
+    {                                                                                     \
+      static_assert(!NOEXC_B || noexcept(FnTraits::invoke_r<RetType>(                     \
+          std::declval<FuncPtr>(), std::declval<ArgsType>()...)),                         \
+        "embed::function_ref with a noexcept Signature requires the function to be"       \
+        " noexcept");                                                                     \
+      return FnTraits::invoke_r<RetType>(reinterpret_cast<FuncPtr>(obj.M_function),       \
+        std::forward<ArgsType>(args)...);                                                 \
+    }                                                                                     \
+    template <typename Functor>                                                           \
+    static RetType M_invoke_stateless(FnRefObject,                                        \
+      FnTraits::invoke_param_t<ArgsType>... args) EMBED_FN_CASE_NOEXCEPT_IF(NOEXC_B)      \
+    {                                                                                     \
+      static_assert(!NOEXC_B || noexcept(FnTraits::invoke_r<RetType>(                     \
+          std::declval<Qualified<Functor>>(), std::declval<ArgsType>()...)),              \
+        "embed::function_ref with a noexcept Signature requires the functor to be"        \
+        " no-throw callable");                                                            \
+      Functor functor{};                                                                  \
+      return FnTraits::invoke_r<RetType>(                                                 \
+        static_cast<Qualified<Functor>>(functor),                                         \
+        std::forward<ArgsType>(args)...);                                                 \
+    }                                                                                     \
+    FnRefObject M_object;                                                                 \
+    Thunk_Type  M_thunk;                                                                  \
+  public:                                                                                 \
+    EMBED_INLINE RetType operator() (ArgsType... args) const                              \
+    EMBED_FN_CASE_NOEXCEPT_IF(NOEXC_B) {                                                  \
+      return M_thunk(M_object, std::forward<ArgsType>(args)...);                          \
+    }                                                                                     \
+  };
+
+#define EMBED_FN_REF_HELPER_CODE(C, V, REF)                       \
+  EMBED_FN_REF_HELPER_CODE_IMPL(C, V, REF, , false)
+
+  // Use macro to generate code. (Overload for `FnRefHelper`)
+  EMBED_FN_GENERATE_CODE_C_V_REF(EMBED_FN_REF_HELPER_CODE)
+
+#if EMBED_CXX_VERSION >= 201703L
+# undef EMBED_FN_REF_HELPER_CODE
+# define EMBED_FN_REF_HELPER_CODE(C, V, REF)                      \
+  EMBED_FN_REF_HELPER_CODE_IMPL(C, V, REF, noexcept, true)
+
+  // Overload for the noexcept Signature. (Since C++17)
+  EMBED_FN_GENERATE_CODE_C_V_REF(EMBED_FN_REF_HELPER_CODE)
+#endif
+
+#undef EMBED_FN_REF_HELPER_CODE
+#undef EMBED_FN_REF_HELPER_CODE_IMPL
+
+} // end namespace embed::detail
+
+  /**
+   * @brief   `embed::function_ref` is a non-owning view of a callable object,
+   * two pointers in total and trivially copyable. It is never empty.
+   * @attention The referred object MUST outlive the `embed::function_ref`.
+   * Use it for the callback which is only called synchronously, e.g. the
+   * parameter of an algorithm.
+   */
+  template <typename Signature>
+  class function_ref
+  : public detail::FnRefHelper<Signature>
+  {
+  private:
+    using MyRefHelper = detail::FnRefHelper<Signature>;
+    using FnTraits = detail::FnToolBox::FnTraits;
+
+    using MyRefHelper::M_object;
+    using MyRefHelper::M_thunk;
+
+    template <typename Functor>
+    using DecayFunc_t = typename std::enable_if<
+      !std::is_same<function_ref, FnTraits::remove_cvref_t<Functor> >::value,
+      typename std::decay<Functor>::type
+    >::type;
+
+    template <typename DecayFunctor>
+    using is_function_pointer = std::integral_constant<bool,
+      std::is_pointer<DecayFunctor>::value
+      && std::is_function<typename std::remove_pointer<DecayFunctor>::type>::value>;
+
+    // Refer to a free function. (The function pointer is copied)
+    template <typename Functor>
+    EMBED_INLINE void M_bind(Functor&& func, std::true_type) noexcept
+    {
+      using FuncPtr = typename std::decay<Functor>::type;
+      M_object.M_function = reinterpret_cast<void (*) ()>(static_cast<FuncPtr>(func));
+      M_thunk = &MyRefHelper::template M_invoke_function<FuncPtr>;
+    }
+
+    // Refer to a callable object.
+    template <typename Functor>
+    EMBED_INLINE void M_bind(Functor&& func, std::false_type) noexcept
+    {
+      using Object = typename std::remove_reference<Functor>::type;
+      M_object.M_object = const_cast<void*>(
+        static_cast<const volatile void*>(std::addressof(func)));
+      M_thunk = &MyRefHelper::template M_invoke_object<Object>;
+    }
+
+  public:
+    using result_type = typename FnTraits::unwrap_signature<Signature>::ret;
+
+    /**
+     * @brief Refer to `func`, a free function or a callable object
+     * (including `embed::Fn`).
+     * @note `func` MUST NOT be a null function pointer.
+     */
+    template <typename Functor,
+      typename DecayFunctor = DecayFunc_t<Functor> >
+    function_ref(Functor&& func) noexcept
+    {
+      static_assert(is_function_pointer<DecayFunctor>::value
+        || MyRefHelper::template Callable<
+          typename std::remove_reference<Functor>::type>::value,
+        "embed::function_ref requires the Functor is callable and the Signature"
+        " match RetType");
+
+      M_bind(std::forward<Functor>(func), is_function_pointer<DecayFunctor>{});
+    }
+
+#if EMBED_CXX_VERSION >= 201703L
+    // Refer to a free function bound at compile time, nothing is stored.
+    template <auto Func>
+    function_ref(nontype_t<Func>) noexcept
+    {
+      M_object.M_object = nullptr;
+      M_thunk = &MyRefHelper::template M_invoke_stateless<nontype_t<Func>>;
+    }
+#endif
+  };
 
   /**
    * @brief Make a function and automatically calculate the required size.
@@ -2409,6 +5827,43 @@ namespace detail {
     return function<Signature>(func);
   }
 
+#if EMBED_CXX_VERSION >= 201703L
+
+namespace detail {
+
+  template <typename FuncPtr>
+  struct nontype_signature;
+
+  template <typename RetType, typename... ArgsType>
+  struct nontype_signature<RetType (*) (ArgsType...)>
+  { using type = RetType(ArgsType...) const; };
+
+  template <typename RetType, typename... ArgsType>
+  struct nontype_signature<RetType (*) (ArgsType...) noexcept>
+  { using type = RetType(ArgsType...) const noexcept; };
+
+} // end namespace embed::detail
+
+  // Overload for free function bound at compile time. (Since C++17)
+  template <auto Func>
+  EMBED_NODISCARD inline function<
+    typename detail::nontype_signature<decltype(Func)>::type, sizeof(nontype_t<Func>)>
+  make_function(nontype_t<Func> = {}) noexcept
+  {
+    return function<typename detail::nontype_signature<decltype(Func)>::type,
+      sizeof(nontype_t<Func>)>(nontype_t<Func>{});
+  }
+
+  // Overload for free function bound at compile time with specified signature.
+  template <typename Signature, auto Func>
+  EMBED_NODISCARD inline function<Signature, sizeof(nontype_t<Func>)>
+  make_function(nontype_t<Func> = {}) noexcept
+  {
+    return function<Signature, sizeof(nontype_t<Func>)>(nontype_t<Func>{});
+  }
+
+#endif
+
   // Overload for lambda function or other object which
   // uniquely override the `operator()`.
   template <typename Lambda,
@@ -2428,32 +5883,36 @@ namespace detail {
   }
 
   // Overload for `embed::Fn`. (Copy)
-  template <typename Signature, std::size_t BufSize>
-  EMBED_NODISCARD inline function<Signature, BufSize>
-  make_function(const Fn<Signature, BufSize>& fn) noexcept
+  template <typename Signature, std::size_t BufSize, bool FastCall, std::size_t Align,
+    typename Pool>
+  EMBED_NODISCARD inline Fn<Signature, BufSize, FastCall, Align, Pool>
+  make_function(const Fn<Signature, BufSize, FastCall, Align, Pool>& fn) noexcept
   {
-    return function<Signature, BufSize>(fn);
+    return Fn<Signature, BufSize, FastCall, Align, Pool>(fn);
   }
 
   // Overload for `embed::Fn`. (Move)
-  template <typename Signature, std::size_t BufSize>
-  EMBED_NODISCARD inline function<Signature, BufSize>
-  make_function(Fn<Signature, BufSize>&& fn) noexcept
+  template <typename Signature, std::size_t BufSize, bool FastCall, std::size_t Align,
+    typename Pool>
+  EMBED_NODISCARD inline Fn<Signature, BufSize, FastCall, Align, Pool>
+  make_function(Fn<Signature, BufSize, FastCall, Align, Pool>&& fn) noexcept
   {
-    return function<Signature, BufSize>(std::move(fn));
+    return Fn<Signature, BufSize, FastCall, Align, Pool>(std::move(fn));
   }
 
   // Overload for `embed::Fn<Other, Size>`.
-  template <typename Signature, typename OtherSignature, std::size_t BufSize>
+  template <typename Signature, typename OtherSignature,
+    std::size_t BufSize, bool FastCall, std::size_t Align,
+    typename Pool>
   EMBED_NODISCARD inline typename std::enable_if<
     detail::FnToolBox::FnTraits::is_similar_Fn_signature<
-      Signature, OtherSignature, BufSize, BufSize
+      Signature, OtherSignature
     >::value,
-    function<Signature, BufSize>
+    Fn<Signature, BufSize, FastCall, Align, Pool>
   >::type
-  make_function(const Fn<OtherSignature, BufSize>& fn) noexcept
+  make_function(const Fn<OtherSignature, BufSize, FastCall, Align, Pool>& fn) noexcept
   {
-    return function<Signature, BufSize>(fn);
+    return Fn<Signature, BufSize, FastCall, Align, Pool>(fn);
   }
 
   // Overload for member function.
@@ -2491,11 +5950,13 @@ namespace detail {
 
   template <typename T> struct function_deduce_get_signature;
 
-  template <typename Sig, std::size_t Buf>
-  struct function_deduce_get_signature<Fn<Sig, Buf>>
+  template <typename Sig, std::size_t Buf, bool Fast, std::size_t Align>
+  struct function_deduce_get_signature<Fn<Sig, Buf, Fast, Align>>
   {
     using signature = Sig;
     static constexpr std::size_t bufsize = Buf;
+    static constexpr bool fast = Fast;
+    static constexpr std::size_t align = Align;
   };
 
 } // end namespace embed::detail
@@ -2503,8 +5964,10 @@ namespace detail {
   template <typename Functor,
     typename DeduceRet = typename detail::function_deduce_guide_helper<Functor>::type,
     typename Signature = typename detail::function_deduce_get_signature<DeduceRet>::signature,
-    std::size_t BufferSize = detail::function_deduce_get_signature<DeduceRet>::bufsize>
-  Fn(Functor) -> Fn<Signature, BufferSize>;
+    std::size_t BufferSize = detail::function_deduce_get_signature<DeduceRet>::bufsize,
+    bool FastCall = detail::function_deduce_get_signature<DeduceRet>::fast,
+    std::size_t Align = detail::function_deduce_get_signature<DeduceRet>::align>
+  Fn(Functor) -> Fn<Signature, BufferSize, FastCall, Align>;
 
 #endif
 
@@ -2519,22 +5982,39 @@ EMBED_POP_STD
 namespace std EMBED_ABI_VISIBILITY(default)
 {
 
-  template<typename Signature, decltype(sizeof(int)) BufSize>
+  template<typename Signature, decltype(sizeof(int)) BufSize, bool FastCall,
+    decltype(sizeof(int)) Align, typename Pool>
+  inline void swap(
+    embed::Fn<Signature, BufSize, FastCall, Align, Pool>& fn1,
+    embed::Fn<Signature, BufSize, FastCall, Align, Pool>& fn2
+  ) noexcept { fn1.swap(fn2); }
+
+#if defined(EMBED_NO_STD_HEADER)
+  // There is no generic `std::swap` without the standard headers.
+  // (The other wrappers built on `FnWrapper`, which swaps them by ADL)
+  template<typename Wrapper>
+  inline typename embed::detail::fn_no_std::enable_if<
+    embed::detail::fn_no_std::is_base_of<embed::detail::FnWrapperTag, Wrapper>::value
+  >::type swap(Wrapper& fn1, Wrapper& fn2) noexcept { fn1.swap(fn2); }
+#endif
+
+  template<typename Signature>
   inline void swap(
-    embed::Fn<Signature, BufSize>& fn1,
-    embed::Fn<Signature, BufSize>& fn2
+    embed::stateless_function<Signature>& fn1,
+    embed::stateless_function<Signature>& fn2
   ) noexcept { fn1.swap(fn2); }
 
 }
 
 
 #undef EMBED_FN_NEED_FAST_CALL
+#undef EMBED_FN_EMPTY_SENTINEL
 #undef EMBED_FN_NOTHROW_CALLABLE
 #undef EMBED_FN_CASE_NOEXCEPT
+#undef EMBED_FN_CASE_NOEXCEPT_IF
 #undef EMBED_FN_ENSURE_NO_THROW
 #undef EMBED_FN_NO_WARING
 #undef EMBED_FN_GENERATE_CODE_C_V_REF
-#undef EMBED_FN_SWITCH_EXPECT
 
 #if defined(_MSC_VER)
 # pragma warning(pop)
@@ -84,6 +84,15 @@ namespace embed { namespace detail { namespace fn_no_std {
   // std::nullptr_t
   using nullptr_t = decltype(nullptr);
 
+  // std::uint16_t, std::uint32_t
+#if defined(__UINT16_TYPE__) && defined(__UINT32_TYPE__)
+  using uint16_t = __UINT16_TYPE__;
+  using uint32_t = __UINT32_TYPE__;
+#else
+  using uint16_t = unsigned short;
+  using uint32_t = unsigned int;
+#endif
+
   // std::exception
   class exception {
   public:
@@ -352,6 +361,59 @@ namespace embed { namespace detail { namespace fn_no_std {
   : public true_type {};
 #endif
 
+  // std::is_trivially_copyable
+  // If the builtin cannot be used, every functor is regarded as
+  // non-trivial, which is always safe (but a little bit slower).
+#if EMBED_HAS_BUILTIN(__is_trivially_copyable) || ( defined(__GNUC__) && (__GNUC__ >= 5) )
+  template <class _Tp>
+  struct is_trivially_copyable
+  : public integral_constant<bool, __is_trivially_copyable(_Tp)> {};
+#else
+  template <class _Tp>
+  struct is_trivially_copyable
+  : public false_type {};
+#endif
+
+  // std::is_trivially_constructible
+  // If the builtin cannot be used, no class is regarded as trivially
+  // constructible, which is always safe.
+#if EMBED_HAS_BUILTIN(__is_trivially_constructible) || ( defined(__GNUC__) && (__GNUC__ >= 5) )
+  template <class _Tp, class... _Args>
+  struct is_trivially_constructible
+  : public integral_constant<bool, __is_trivially_constructible(_Tp, _Args...)> {};
+#else
+  template <class _Tp, class... _Args>
+  struct is_trivially_constructible
+  : public false_type {};
+#endif
+
+  // std::is_trivially_destructible
+#if EMBED_HAS_BUILTIN(__is_trivially_destructible)
+  template <class _Tp>
+  struct is_trivially_destructible
+  : public integral_constant<bool, __is_trivially_destructible(_Tp)> {};
+#elif defined(__GNUC__) && (__GNUC__ >= 5)
+  template <class _Tp>
+  struct is_trivially_destructible
+  : public integral_constant<bool, __has_trivial_destructor(_Tp)> {};
+#else
+  template <class _Tp>
+  struct is_trivially_destructible
+  : public false_type {};
+#endif
+
+  // std::is_empty
+  // If the builtin cannot be used, no class is regarded as empty.
+#if EMBED_HAS_BUILTIN(__is_empty) || defined(__GNUC__) || defined(_MSC_VER)
+  template <class _Tp>
+  struct is_empty
+  : public integral_constant<bool, __is_empty(_Tp)> {};
+#else
+  template <class _Tp>
+  struct is_empty
+  : public false_type {};
+#endif
+
   template <class _Tp, bool = _is_referenceable<_Tp>::value>
   struct __add_rvalue_reference_impl {
     using type = _Tp;
@@ -647,12 +709,12 @@ namespace embed { namespace detail { namespace fn_no_std {
 
 #if EMBED_HAS_BUILTIN(__builtin_addressof)
   template <typename T>
-  EMBED_INLINE T* addressof(T& t) noexcept {
+  EMBED_INLINE constexpr T* addressof(T& t) noexcept {
     return __builtin_addressof(t);
   }
 #else
   template <typename T>
-  EMBED_INLINE T* addressof(T& t) noexcept {
+  EMBED_INLINE constexpr T* addressof(T& t) noexcept {
     return &t;
   }
 #endif
@@ -706,6 +768,46 @@ namespace embed { namespace detail { namespace fn_no_std {
     __y = move(__t);
   }
 
+  // std::atomic (only the operations used by embed::fixed_block_pool)
+  template <typename T>
+  class atomic
+  {
+  private:
+    T M_value;
+
+  public:
+    atomic() noexcept = default;
+    constexpr atomic(T value) noexcept : M_value(value) {}
+
+    atomic(const atomic&) = delete;
+    atomic& operator=(const atomic&) = delete;
+
+#if defined(__GNUC__) || defined(__clang__)
+    EMBED_INLINE T load() const noexcept
+    { return __atomic_load_n(&M_value, __ATOMIC_SEQ_CST); }
+
+    EMBED_INLINE T fetch_add(T value) noexcept
+    { return __atomic_fetch_add(&M_value, value, __ATOMIC_SEQ_CST); }
+
+    EMBED_INLINE T fetch_sub(T value) noexcept
+    { return __atomic_fetch_sub(&M_value, value, __ATOMIC_SEQ_CST); }
+
+    EMBED_INLINE T fetch_and(T value) noexcept
+    { return __atomic_fetch_and(&M_value, value, __ATOMIC_SEQ_CST); }
+
+    EMBED_INLINE bool compare_exchange_weak(T& expected, T desired) noexcept
+    {
+      return __atomic_compare_exchange_n(&M_value, &expected, desired,
+        true, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    }
+#else
+    // Plain reads and writes are not safe for a pool used from interrupts.
+    static_assert(sizeof(T) == 0 /* always false */,
+      "embed::fixed_block_pool requires the `__atomic` builtins of the"
+      " compiler, or the <atomic> header (undefine EMBED_NO_STD_HEADER)");
+#endif
+  };
+
 } } } // end namespace embed::detail::fn_no_std
 
 #if 1
@@ -1,16 +1,37 @@
 #include "embed/embed_function.hpp"
 #include "test.hpp"
 
+#if defined(__unix__) || defined(__APPLE__)
+# include <signal.h>
+# include <sys/wait.h>
+# include <unistd.h>
+# define TEST_ASSIGN_CAN_FORK 1
+#endif
+
 TEST_FUNCTION_DECLARE(AssignTest, Copy_Assignment);
 TEST_FUNCTION_DECLARE(AssignTest, Move_Assignment);
 TEST_FUNCTION_DECLARE(AssignTest, Nullptr_Assignment);
 TEST_FUNCTION_DECLARE(AssignTest, Similar_Assignment);
+TEST_FUNCTION_DECLARE(AssignTest, Trivial_Target_Assignment);
+TEST_FUNCTION_DECLARE(AssignTest, Copy_MoveOnly_Aborts);
+TEST_FUNCTION_DECLARE(AssignTest, Relocate_Lifecycle);
+TEST_FUNCTION_DECLARE(AssignTest, Empty_State);
+TEST_FUNCTION_DECLARE(AssignTest, Emplace_In_Place);
+TEST_FUNCTION_DECLARE(AssignTest, Assign_Owned_By_Target);
+TEST_FUNCTION_DECLARE(AssignTest, Copy_Assign_In_Place);
 
 TEST_SUBSYS(AssignTest, main) {
     TEST_RUN(AssignTest, Copy_Assignment);
     TEST_RUN(AssignTest, Move_Assignment);
     TEST_RUN(AssignTest, Nullptr_Assignment);
     TEST_RUN(AssignTest, Similar_Assignment);
+    TEST_RUN(AssignTest, Trivial_Target_Assignment);
+    TEST_RUN(AssignTest, Copy_MoveOnly_Aborts);
+    TEST_RUN(AssignTest, Relocate_Lifecycle);
+    TEST_RUN(AssignTest, Empty_State);
+    TEST_RUN(AssignTest, Emplace_In_Place);
+    TEST_RUN(AssignTest, Assign_Owned_By_Target);
+    TEST_RUN(AssignTest, Copy_Assign_In_Place);
 }
 
 int test_assign_free_func(int a) { return a * 2; }
@@ -98,7 +119,324 @@ TEST(AssignTest, Similar_Assignment) {
 #if !defined(EMBED_NO_STD_HEADER)
     ASSERT_EQ((std::is_constructible<fn_t, fn_similar_t>::value), true, "%d");
     ASSERT_EQ((std::is_assignable<fn_t, fn_similar_t>::value), true, "%d");
+
+    // Narrowing is rejected at compile time, never nested.
+    ASSERT_EQ((std::is_constructible<fn_similar_t, fn_t>::value), false, "%d");
+    ASSERT_EQ((std::is_constructible<fn_similar_t, const fn_t&>::value), false, "%d");
+    ASSERT_EQ((std::is_assignable<fn_similar_t&, fn_t>::value), false, "%d");
+#endif
+
+    // Widening relocates the target itself, a nested embed::Fn could not
+    // fit in `2 * sizeof(void*)` together with the full-size target.
+    using fn_small_t = embed::function<int(int), 2 * sizeof(int)>;
+    using fn_large_t = embed::function<int(int), 2 * sizeof(void*)>;
+    int a = 3, b = 4;
+    fn_small_t fn1 = [a, b](int x) { return x * a + b; };
+    fn_large_t fn2 = fn1;
+    ASSERT_EQ(fn2(1), 7, "%d");
+    ASSERT_EQ(fn1(2), 10, "%d");
+
+    fn_large_t fn3 = std::move(fn1);
+    ASSERT_EQ(fn3(2), 10, "%d");
+    ASSERT_EQ(fn1.is_empty(), true, "%d");
+
+    fn1 = test_assign_free_func;
+    fn3 = fn1;
+    ASSERT_EQ(fn3(5), 10, "%d");
+
+    return 0;
+}
+
+// A target with a user-provided destructor, which is not trivial.
+struct testUse__NonTrivialAdd_ {
+    int k;
+    explicit testUse__NonTrivialAdd_(int v) noexcept : k(v) {}
+    ~testUse__NonTrivialAdd_() noexcept {}
+    int operator()(int a) const { return a + k; }
+};
+
+TEST(AssignTest, Trivial_Target_Assignment) {
+    int base = 5;
+    using fn_t = embed::function<int(int)>;
+
+    // Trivially copyable targets (free function, captureless lambda,
+    // small POD-capture lambda) are copied without the manager.
+    fn_t fn1 = test_assign_free_func;
+    fn_t fn2 = [](int a) { return a - 1; };
+    fn_t fn3 = [base](int a) { return a + base; };
+    fn_t fn4;
+
+    fn4 = fn3;
+    ASSERT_EQ(fn4(1), 6, "%d");
+    ASSERT_EQ(fn3(1), 6, "%d");
+
+    fn_t fn5(std::move(fn2));
+    ASSERT_EQ(static_cast<bool>(fn2), false, "%d");
+    ASSERT_EQ(fn5(1), 0, "%d");
+
+    fn1.swap(fn5);
+    ASSERT_EQ(fn1(1), 0, "%d");
+    ASSERT_EQ(fn5(1), 2, "%d");
+
+    fn1.swap(fn2);
+    ASSERT_EQ(static_cast<bool>(fn1), false, "%d");
+    ASSERT_EQ(fn2(1), 0, "%d");
+
+    // Mix a trivial move-only target and a trivial copyable one.
+#if !defined(EMBED_NO_NONCOPYABLE_FUNCTOR)
+    fn1 = testUse__MoveOnlyClass_{};
+    fn1.swap(fn3);
+    ASSERT_EQ(fn1(1), 6, "%d");
+    ASSERT_EQ(fn3(4), 8, "%d");
+#endif
+
+    // Mix trivial and non-trivial targets.
+    fn4 = testUse__NonTrivialAdd_(100);
+    fn4.swap(fn2);
+    ASSERT_EQ(fn2(1), 101, "%d");
+    ASSERT_EQ(fn4(1), 0, "%d");
+
+    fn4 = fn2;
+    ASSERT_EQ(fn4(1), 101, "%d");
+    fn2 = fn5;
+    ASSERT_EQ(fn2(1), 2, "%d");
+    ASSERT_EQ(fn4(2), 102, "%d");
+
+    return 0;
+}
+
+TEST(AssignTest, Copy_MoveOnly_Aborts) {
+#if !defined(EMBED_NO_NONCOPYABLE_FUNCTOR) && defined(TEST_ASSIGN_CAN_FORK)
+    // `testUse__MoveOnlyClass_` is trivially copyable, but its copy
+    // constructor is deleted, so copying it must not be a raw byte copy:
+    // `bad_function_copy_handler` terminates the (child) process.
+    embed::function<int(int)> fn = testUse__MoveOnlyClass_{};
+
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        embed::function<int(int)> copy(fn);
+        _exit(copy(3) == 6 ? 0 : 1);
+    }
+
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0) == pid, true, "%d");
+    ASSERT_EQ(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT, true, "%d");
+    ASSERT_EQ(fn(3), 6, "%d");
+#endif
+    return 0;
+}
+
+TEST(AssignTest, Relocate_Lifecycle) {
+    using fn_t = embed::function<int(int)>;
+    using fn_big_t = embed::function<int(int), 2 * sizeof(void*)>;
+    {
+        fn_t fn1 = testUse__Counter(1);
+        fn_t fn2 = testUse__Counter(2);
+        fn_t fn3 = test_assign_free_func;
+        ASSERT_EQ(testUse__Counter::alive(), 2, "%d");
+
+        // swap: non-trivial <-> non-trivial, non-trivial <-> trivial
+        fn1.swap(fn2);
+        ASSERT_EQ(fn1(0), 2, "%d");
+        ASSERT_EQ(fn2(0), 1, "%d");
+        fn1.swap(fn3);
+        ASSERT_EQ(fn1(1), 2, "%d");
+        ASSERT_EQ(fn3(0), 2, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 2, "%d");
+
+        // move construct / move assign
+        fn_t fn4(std::move(fn2));
+        ASSERT_EQ(static_cast<bool>(fn2), false, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 2, "%d");
+        fn4 = std::move(fn3);
+        ASSERT_EQ(fn4(0), 2, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 1, "%d");
+
+        // copy assign: into empty, into trivial, into non-trivial
+        fn2 = fn4;
+        fn1 = fn4;
+        ASSERT_EQ(testUse__Counter::alive(), 3, "%d");
+        fn1 = fn2;
+        ASSERT_EQ(fn1(0), 2, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 3, "%d");
+
+        // functor assign
+        fn1 = testUse__Counter(7);
+        ASSERT_EQ(fn1(0), 7, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 3, "%d");
+
+        // self swap / self move
+        fn1.swap(fn1);
+        fn_t& fn1_ref = fn1;
+        fn1 = std::move(fn1_ref);
+        ASSERT_EQ(fn1(0), 7, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 3, "%d");
+
+        // move into a larger buffer
+        fn_big_t fn5(std::move(fn1));
+        ASSERT_EQ(static_cast<bool>(fn1), false, "%d");
+        ASSERT_EQ(fn5(0), 7, "%d");
+        fn_big_t fn6;
+        fn6 = std::move(fn2);
+        ASSERT_EQ(fn6(0), 2, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 3, "%d");
+    }
+    ASSERT_EQ(testUse__Counter::alive(), 0, "%d");
+
+    return 0;
+}
+
+TEST(AssignTest, Empty_State) {
+    using fn_t = embed::function<int(int)>;
+    using fn_big_t = embed::function<int(int), 2 * sizeof(void*)>;
+
+    // The empty state (`nullptr` or the sentinel, see EMBED_FN_EMPTY_SENTINEL)
+    // must survive copy, move, swap and conversion.
+    fn_t fn1;
+    fn_t fn2(nullptr);
+    fn_t fn3(fn1);
+    fn_t fn4(std::move(fn2));
+    ASSERT_EQ(fn1 == nullptr, true, "%d");
+    ASSERT_EQ(fn3 == nullptr, true, "%d");
+    ASSERT_EQ(fn4 == nullptr, true, "%d");
+
+    fn_big_t fn5(fn1);
+    fn_big_t fn6(std::move(fn1));
+    ASSERT_EQ(fn5.is_empty(), true, "%d");
+    ASSERT_EQ(fn6.is_empty(), true, "%d");
+
+    fn5 = test_assign_free_func;
+    fn5 = fn3;
+    ASSERT_EQ(fn5.is_empty(), true, "%d");
+
+    fn3 = test_assign_free_func;
+    fn3.swap(fn4);
+    ASSERT_EQ(fn3.is_empty(), true, "%d");
+    ASSERT_EQ(fn4(2), 4, "%d");
+
+    fn4 = nullptr;
+    ASSERT_EQ(static_cast<bool>(fn4), false, "%d");
+    fn4 = fn_t(test_assign_free_func2);
+    ASSERT_EQ(fn4(2), 12, "%d");
+
+    // A volatile embed::Fn target is checked against the same empty state.
+    using helper_t = embed::detail::FnToolBox::FnManagerHelper<
+        int(int), fn_t, sizeof(fn_t), false, false, false>;
+    volatile fn_t vfn1;
+    volatile fn_t vfn2(test_assign_free_func);
+    ASSERT_EQ(helper_t::M_not_empty_function(vfn1), false, "%d");
+    ASSERT_EQ(helper_t::M_not_empty_function(vfn2), true, "%d");
+
+    return 0;
+}
+
+// Constructed from more than one argument, so it needs the in-place API.
+struct testUse__Affine_ {
+    int scale;
+    int offset;
+    testUse__Affine_(int s, int o) noexcept : scale(s), offset(o) {}
+    int operator()(int a) const { return a * scale + offset; }
+};
+
+TEST(AssignTest, Emplace_In_Place) {
+    using fn_t = embed::function<int(int), 2 * sizeof(int)>;
+    {
+        fn_t fn1(embed::in_place_type_t<testUse__Affine_>{}, 2, 1);
+        ASSERT_EQ(fn1(3), 7, "%d");
+
+        // Replace a trivial target by a non-trivial one, and back.
+        testUse__Counter& target = fn1.emplace<testUse__Counter>(5);
+        ASSERT_EQ(target.k, 5, "%d");
+        ASSERT_EQ(fn1(1), 6, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 1, "%d");
+
+        fn1.emplace<testUse__Affine_>(3, 0);
+        ASSERT_EQ(fn1(2), 6, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 0, "%d");
+
+        // Assigning a callable object destroys the old target.
+        fn1 = testUse__Counter(7);
+        fn1 = testUse__Counter(8);
+        ASSERT_EQ(fn1(0), 8, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 1, "%d");
+
+        // A null function pointer leaves it empty.
+        fn1.emplace<int(*)(int)>(nullptr);
+        ASSERT_EQ(fn1.is_empty(), true, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 0, "%d");
+
+        fn1.emplace<int(*)(int)>(test_assign_free_func);
+        ASSERT_EQ(fn1(4), 8, "%d");
+    }
+    ASSERT_EQ(testUse__Counter::alive(), 0, "%d");
+
+#if EMBED_CXX_VERSION >= 201703L
+    fn_t fn2(embed::in_place_type<testUse__Affine_>, 1, 1);
+    ASSERT_EQ(fn2(1), 2, "%d");
 #endif
 
     return 0;
 }
+
+// Records a copy made from an object that was destroyed before.
+struct testUse__CheckedCopy_ {
+    static const void* destroyed;
+    static int bad_copies;
+    int value;
+    explicit testUse__CheckedCopy_(int v) noexcept : value(v) {}
+    testUse__CheckedCopy_(const testUse__CheckedCopy_& o) noexcept : value(o.value)
+    { if (destroyed == &o) ++bad_copies; }
+    ~testUse__CheckedCopy_() noexcept { destroyed = this; }
+    int operator()(int a) const { return a + value; }
+};
+const void* testUse__CheckedCopy_::destroyed = nullptr;
+int testUse__CheckedCopy_::bad_copies = 0;
+
+struct testUse__Outer_ {
+    testUse__CheckedCopy_ inner;
+    explicit testUse__Outer_(int v) noexcept : inner(v) {}
+    int operator()(int a) const { return inner(a) * 2; }
+};
+
+TEST(AssignTest, Assign_Owned_By_Target) {
+    using fn_t = embed::function<int(int)>;
+    fn_t fn1;
+    testUse__Outer_& outer = fn1.emplace<testUse__Outer_>(3);
+    ASSERT_EQ(fn1(1), 8, "%d");
+
+    // The new target is a part of the current one, so it must be
+    // copied before the current one is destroyed.
+    testUse__CheckedCopy_::destroyed = nullptr;
+    fn1 = outer.inner;
+    ASSERT_EQ(testUse__CheckedCopy_::bad_copies, 0, "%d");
+    ASSERT_EQ(fn1(1), 4, "%d");
+
+    embed::move_only_function<int(int)> fn2(embed::in_place_type_t<testUse__Outer_>{}, 5);
+    testUse__Outer_& outer2 = fn2.emplace<testUse__Outer_>(6);
+    testUse__CheckedCopy_::destroyed = nullptr;
+    fn2 = outer2.inner;
+    ASSERT_EQ(testUse__CheckedCopy_::bad_copies, 0, "%d");
+    ASSERT_EQ(fn2(1), 7, "%d");
+
+    return 0;
+}
+
+TEST(AssignTest, Copy_Assign_In_Place) {
+    using fn_t = embed::function<int(int)>;
+    {
+        fn_t fn1 = testUse__Counter(2);
+        fn_t fn2 = testUse__Counter(3);
+        ASSERT_EQ(testUse__Counter::alive(), 2, "%d");
+
+        // Into a non-trivial target: destroy + clone, no temporary.
+        testUse__Counter::copies() = 0;
+        fn2 = fn1;
+        ASSERT_EQ(testUse__Counter::copies(), 1, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 2, "%d");
+        ASSERT_EQ(fn2(4), 6, "%d");
+    }
+    ASSERT_EQ(testUse__Counter::alive(), 0, "%d");
+
+    return 0;
+}
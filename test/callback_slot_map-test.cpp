@@ -0,0 +1,146 @@
+/**
+ * Here is the test for `embed::callback_slot_map`.
+ */
+#include "embed/embed_function.hpp"
+#include "test.hpp"
+
+TEST_FUNCTION_DECLARE(CallbackSlotMapTest, Insert_Erase);
+TEST_FUNCTION_DECLARE(CallbackSlotMapTest, Stale_Handle);
+TEST_FUNCTION_DECLARE(CallbackSlotMapTest, Iterate);
+TEST_FUNCTION_DECLARE(CallbackSlotMapTest, Relocate_Target);
+TEST_FUNCTION_DECLARE(CallbackSlotMapTest, Empty_Callback);
+
+TEST_SUBSYS(CallbackSlotMapTest, main) {
+    TEST_RUN(CallbackSlotMapTest, Insert_Erase);
+    TEST_RUN(CallbackSlotMapTest, Stale_Handle);
+    TEST_RUN(CallbackSlotMapTest, Iterate);
+    TEST_RUN(CallbackSlotMapTest, Relocate_Target);
+    TEST_RUN(CallbackSlotMapTest, Empty_Callback);
+}
+
+static int testUse__slot_twice(int a) { return a * 2; }
+
+TEST(CallbackSlotMapTest, Insert_Erase) {
+    using map_t = embed::callback_slot_map<int(int), 8, 3>;
+    static map_t map;
+
+    ASSERT_EQ(map.empty(), true, "%d");
+    ASSERT_EQ(map_t::capacity(), (std::size_t)3, "%zu");
+
+    int k = 10;
+    map_t::handle_type h1 = map.insert([k](int a) { return a + k; });
+    map_t::handle_type h2 = map.insert(testUse__slot_twice);
+    map_t::handle_type h3 = map.insert([](int a) { return -a; });
+    ASSERT_EQ(h1 != map_t::null_handle && h2 != map_t::null_handle, true, "%d");
+    ASSERT_EQ(h3 != map_t::null_handle, true, "%d");
+    ASSERT_EQ(map.size(), (std::size_t)3, "%zu");
+
+    // Full.
+    ASSERT_EQ(map.insert(testUse__slot_twice) == map_t::null_handle, true, "%d");
+
+    ASSERT_EQ((*map.find(h1))(1), 11, "%d");
+    ASSERT_EQ((*map.find(h2))(3), 6, "%d");
+
+    // Erase the first, the last one is moved into its place.
+    ASSERT_EQ(map.erase(h1), true, "%d");
+    ASSERT_EQ(map.size(), (std::size_t)2, "%zu");
+    ASSERT_EQ(map.contains(h1), false, "%d");
+    ASSERT_EQ((*map.find(h3))(4), -4, "%d");
+    ASSERT_EQ((*map.find(h2))(4), 8, "%d");
+
+    map.clear();
+    ASSERT_EQ(map.empty(), true, "%d");
+    ASSERT_EQ(map.contains(h2) || map.contains(h3), false, "%d");
+
+    return 0;
+}
+
+TEST(CallbackSlotMapTest, Stale_Handle) {
+    embed::callback_slot_map<int(int), 8, 2> map;
+
+    auto h1 = map.insert(testUse__slot_twice);
+    ASSERT_EQ(map.erase(h1), true, "%d");
+    ASSERT_EQ(map.erase(h1), false, "%d");
+
+    // The slot is reused with another generation.
+    auto h2 = map.insert([](int a) { return a - 1; });
+    ASSERT_EQ(h1 != h2, true, "%d");
+    ASSERT_EQ(map.find(h1) == nullptr, true, "%d");
+    ASSERT_EQ((*map.find(h2))(5), 4, "%d");
+    ASSERT_EQ(map.find(0) == nullptr, true, "%d");
+
+    return 0;
+}
+
+TEST(CallbackSlotMapTest, Iterate) {
+    embed::callback_slot_map<int(int), 8, 16> map;
+    std::uint32_t handles[16];
+
+    for (int i = 0; i < 16; ++i)
+        handles[i] = map.insert([i](int a) { return a * i; });
+
+    // Erase the odd ones.
+    for (int i = 1; i < 16; i += 2)
+        ASSERT_EQ(map.erase(handles[i]), true, "%d");
+
+    int sum = 0;
+    int count = 0;
+    for (auto& fn : map) {
+        sum += fn(1);
+        ++count;
+    }
+    ASSERT_EQ(count, 8, "%d");
+    ASSERT_EQ(sum, 0 + 2 + 4 + 6 + 8 + 10 + 12 + 14, "%d");
+
+    for (int i = 0; i < 16; i += 2)
+        ASSERT_EQ((*map.find(handles[i]))(1), i, "%d");
+
+    return 0;
+}
+
+TEST(CallbackSlotMapTest, Relocate_Target) {
+    {
+        embed::callback_slot_map<int(int), 8, 4> map;
+        auto h1 = map.insert(testUse__Counter(1));
+        auto h2 = map.insert(testUse__Counter(2));
+        auto h3 = map.insert(testUse__Counter(3));
+        ASSERT_EQ(testUse__Counter::alive(), 3, "%d");
+
+        // The last target is relocated, not copied.
+        map.erase(h1);
+        ASSERT_EQ(testUse__Counter::alive(), 2, "%d");
+        ASSERT_EQ((*map.find(h3))(0), 3, "%d");
+        ASSERT_EQ((*map.find(h2))(0), 2, "%d");
+
+        map.erase(h3);
+        ASSERT_EQ(testUse__Counter::alive(), 1, "%d");
+    }
+    ASSERT_EQ(testUse__Counter::alive(), 0, "%d");
+
+    return 0;
+}
+
+TEST(CallbackSlotMapTest, Empty_Callback) {
+    using map_t = embed::callback_slot_map<int(int), 8, 2>;
+    map_t map;
+
+    // An empty callback is not added.
+    int (*null_func)(int) = nullptr;
+    embed::function<int(int), 8> empty_fn;
+    ASSERT_EQ(map.insert(nullptr) == map_t::null_handle, true, "%d");
+    ASSERT_EQ(map.insert(null_func) == map_t::null_handle, true, "%d");
+    ASSERT_EQ(map.insert(empty_fn) == map_t::null_handle, true, "%d");
+    ASSERT_EQ(map.empty(), true, "%d");
+
+    // No slot is taken by them.
+    map_t::handle_type h1 = map.insert(testUse__slot_twice);
+    map_t::handle_type h2 = map.insert([](int a) { return a + 1; });
+    ASSERT_EQ(h1 != map_t::null_handle && h2 != map_t::null_handle, true, "%d");
+
+    int sum = 0;
+    for (auto& fn : map)
+        sum += fn(3);
+    ASSERT_EQ(sum, 6 + 4, "%d");
+
+    return 0;
+}
@@ -22,6 +22,7 @@ TEST_FUNCTION_DECLARE(CreateInstanceFromFreeFunction, Return_Void);
 TEST_FUNCTION_DECLARE(CreateInstanceFromFreeFunction, Overloaded_Function);
 TEST_FUNCTION_DECLARE(CreateInstanceFromFreeFunction, Static_Function);
 TEST_FUNCTION_DECLARE(CreateInstanceFromFreeFunction, Namespaced_Function);
+TEST_FUNCTION_DECLARE(CreateInstanceFromFreeFunction, Nontype_Bound_Function);
 
 // Generate a main function for extern call.
 TEST_SUBSYS(CreateInstanceFromFreeFunction, main) {
@@ -42,6 +43,7 @@ TEST_SUBSYS(CreateInstanceFromFreeFunction, main) {
     TEST_RUN(CreateInstanceFromFreeFunction, Overloaded_Function);
     TEST_RUN(CreateInstanceFromFreeFunction, Static_Function);
     TEST_RUN(CreateInstanceFromFreeFunction, Namespaced_Function);
+    TEST_RUN(CreateInstanceFromFreeFunction, Nontype_Bound_Function);
 }
 
 
@@ -327,3 +329,28 @@ TEST(CreateInstanceFromFreeFunction, Namespaced_Function) {
     ASSERT_EQ(fn(123456789ULL), 789, "%d");
     return 0;
 }
+
+// Free function bound at compile time test (C++17)
+TEST(CreateInstanceFromFreeFunction, Nontype_Bound_Function) {
+#if EMBED_CXX_VERSION >= 201703L
+    auto fn1 = embed::make_function<&testUse__free_function_SingleArg>();
+    auto fn2 = embed::make_function<int(int,int,int), &testUse__free_function_MultiSameTypeArgs>();
+    embed::function<int(int)> fn3 = embed::nontype<&testUse__free_function_SingleArg>;
+    embed::Fn fn4 = embed::nontype<&TestNS::static_free_func>;
+
+    ASSERT_EQ(static_cast<bool>(fn1), true, "%d");
+    ASSERT_EQ(static_cast<bool>(fn2), true, "%d");
+    ASSERT_EQ(static_cast<bool>(fn3), true, "%d");
+    ASSERT_EQ(static_cast<bool>(fn4), true, "%d");
+
+    ASSERT_EQ(fn1(42), 42, "%d");
+    ASSERT_EQ(fn2(1, 2, 3), 6, "%d");
+    ASSERT_EQ(fn3(7), 7, "%d");
+    ASSERT_EQ(fn4(5), 50, "%d");
+
+    // Nothing is stored: the buffer can be as small as possible.
+    static_assert(sizeof(fn1) <= sizeof(embed::function<int(int), 1>),
+        "embed::nontype_t must not need any buffer");
+#endif
+    return 0;
+}
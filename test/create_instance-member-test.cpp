@@ -15,6 +15,7 @@ TEST_FUNCTION_DECLARE(CreateInstanceFromMemberFunction, Const_MemberFunc);
 TEST_FUNCTION_DECLARE(CreateInstanceFromMemberFunction, Volatile_MemberFunc);
 TEST_FUNCTION_DECLARE(CreateInstanceFromMemberFunction, MemberFunc_WithArgs);
 TEST_FUNCTION_DECLARE(CreateInstanceFromMemberFunction, FnDeduction);
+TEST_FUNCTION_DECLARE(CreateInstanceFromMemberFunction, Delegate_Bound_Member);
 
 // Test subsys main entry
 TEST_SUBSYS(CreateInstanceFromMemberFunction, main) {
@@ -24,6 +25,7 @@ TEST_SUBSYS(CreateInstanceFromMemberFunction, main) {
     TEST_RUN(CreateInstanceFromMemberFunction, Volatile_MemberFunc);
     TEST_RUN(CreateInstanceFromMemberFunction, MemberFunc_WithArgs);
     TEST_RUN(CreateInstanceFromMemberFunction, FnDeduction);
+    TEST_RUN(CreateInstanceFromMemberFunction, Delegate_Bound_Member);
 }
 
 // Test class for member function tests
@@ -137,3 +139,35 @@ TEST(CreateInstanceFromMemberFunction, FnDeduction) {
 #endif
     return 0;
 }
+
+TEST(CreateInstanceFromMemberFunction, Delegate_Bound_Member) {
+#if EMBED_CXX_VERSION >= 201703L
+    TestClass obj;
+    const TestClass& cobj = obj;
+
+    // Only `this` is stored.
+    auto d1 = embed::delegate<&TestClass::non_static_func>(obj);
+    ASSERT_EQ(sizeof(d1), sizeof(void*), "%zu");
+    ASSERT_EQ(d1(), 1234, "%d");
+
+    // Convert into embed::Fn without growing the buffer.
+    auto fn1 = embed::make_function(d1);
+    ASSERT_EQ(decltype(fn1)::buffer_size, sizeof(void*), "%zu");
+    ASSERT_EQ(fn1(), 1234, "%d");
+
+    embed::function<int() const> fn2 = embed::delegate<&TestClass::const_func>(cobj);
+    ASSERT_EQ(fn2(), 9012, "%d");
+
+    embed::Fn fn3 = embed::delegate<&TestClass::volatile_func>(obj);
+    ASSERT_EQ(fn3(), 3456, "%d");
+
+    embed::delegate<&TestClass::rvalue_ref_func> d4(obj);
+    ASSERT_EQ(d4(), 56789, "%d");
+
+# if !defined(EMBED_NO_STD_HEADER)
+    auto d5 = embed::delegate<&TestClass::arg_func>(obj);
+    ASSERT_EQ_STR(d5("delegate_", 7).c_str(), "delegate_7");
+# endif
+#endif
+    return 0;
+}
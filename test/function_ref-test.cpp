@@ -0,0 +1,107 @@
+/**
+ * Here is the test for `embed::function_ref`.
+ */
+#include "embed/embed_function.hpp"
+#include "test.hpp"
+
+TEST_FUNCTION_DECLARE(FunctionRefTest, Layout);
+TEST_FUNCTION_DECLARE(FunctionRefTest, Free_Function);
+TEST_FUNCTION_DECLARE(FunctionRefTest, Callable_Object);
+TEST_FUNCTION_DECLARE(FunctionRefTest, From_Fn);
+TEST_FUNCTION_DECLARE(FunctionRefTest, Qualifier);
+
+TEST_SUBSYS(FunctionRefTest, main) {
+    TEST_RUN(FunctionRefTest, Layout);
+    TEST_RUN(FunctionRefTest, Free_Function);
+    TEST_RUN(FunctionRefTest, Callable_Object);
+    TEST_RUN(FunctionRefTest, From_Fn);
+    TEST_RUN(FunctionRefTest, Qualifier);
+}
+
+static int testUse__ref_add_one(int a) { return a + 1; }
+
+// An algorithm which only calls the callback synchronously.
+static int testUse__ref_sum(embed::function_ref<int(int)> fn, int n) {
+    int sum = 0;
+    for (int i = 0; i < n; ++i)
+        sum += fn(i);
+    return sum;
+}
+
+TEST(FunctionRefTest, Layout) {
+    using ref_t = embed::function_ref<int(int)>;
+
+    ASSERT_EQ(sizeof(ref_t), 2 * sizeof(void*), "%zu");
+    static_assert(std::is_trivially_copyable<ref_t>::value,
+        "embed::function_ref must be trivially copyable");
+
+    return 0;
+}
+
+TEST(FunctionRefTest, Free_Function) {
+    ASSERT_EQ(testUse__ref_sum(testUse__ref_add_one, 3), 6, "%d");
+    ASSERT_EQ(testUse__ref_sum(&testUse__ref_add_one, 3), 6, "%d");
+
+    embed::function_ref<int(int)> ref = testUse__ref_add_one;
+    embed::function_ref<int(int)> copy = ref;
+    ASSERT_EQ(copy(1), 2, "%d");
+
+#if EMBED_CXX_VERSION >= 201703L
+    embed::function_ref<int(int)> bound = embed::nontype<&testUse__ref_add_one>;
+    ASSERT_EQ(bound(2), 3, "%d");
+#endif
+
+    return 0;
+}
+
+struct testUse__RefCounter_ {
+    int total;
+    int operator()(int a) { return total += a; }
+};
+
+TEST(FunctionRefTest, Callable_Object) {
+    int base = 10;
+    auto la = [base](int a) { return a + base; };
+    ASSERT_EQ(testUse__ref_sum(la, 3), 33, "%d");
+
+    // The object is referred, not copied.
+    testUse__RefCounter_ counter{0};
+    testUse__ref_sum(counter, 4);
+    ASSERT_EQ(counter.total, 6, "%d");
+
+    return 0;
+}
+
+TEST(FunctionRefTest, From_Fn) {
+    embed::function<int(int)> fn = [](int a) { return a * 2; };
+    ASSERT_EQ(testUse__ref_sum(fn, 3), 6, "%d");
+
+    // Follows the target of the referred embed::Fn.
+    embed::function_ref<int(int)> ref = fn;
+    fn = testUse__ref_add_one;
+    ASSERT_EQ(ref(1), 2, "%d");
+
+    return 0;
+}
+
+struct testUse__RefQualified_ {
+    int operator()(int a) const & { return a; }
+    int operator()(int a) && { return -a; }
+};
+
+TEST(FunctionRefTest, Qualifier) {
+    testUse__RefQualified_ obj;
+
+    embed::function_ref<int(int) const> ref1 = obj;
+    embed::function_ref<int(int) &&> ref2 = obj;
+    ASSERT_EQ(ref1(3), 3, "%d");
+    ASSERT_EQ(std::move(ref2)(3), -3, "%d");
+
+#if EMBED_CXX_VERSION >= 201703L
+    embed::function_ref<int(int) noexcept> ref3 = [](int a) noexcept { return a + 2; };
+    static_assert(noexcept(ref3(1)), "operator() of a noexcept Signature must be noexcept");
+    ASSERT_EQ(ref3(1), 3, "%d");
+#endif
+
+    return 0;
+}
@@ -0,0 +1,177 @@
+/**
+ * Here is the test for `embed::function_table`.
+ */
+#include "embed/embed_function.hpp"
+#include "test.hpp"
+
+#if !defined(EMBED_NO_STD_HEADER)
+#include <string>
+#endif
+
+TEST_FUNCTION_DECLARE(FunctionTableTest, Push_Invoke);
+TEST_FUNCTION_DECLARE(FunctionTableTest, Invoke_Range);
+TEST_FUNCTION_DECLARE(FunctionTableTest, Erase);
+TEST_FUNCTION_DECLARE(FunctionTableTest, Relocate_Target);
+TEST_FUNCTION_DECLARE(FunctionTableTest, Value_Argument);
+TEST_FUNCTION_DECLARE(FunctionTableTest, Rvalue_Argument);
+
+TEST_SUBSYS(FunctionTableTest, main) {
+    TEST_RUN(FunctionTableTest, Push_Invoke);
+    TEST_RUN(FunctionTableTest, Invoke_Range);
+    TEST_RUN(FunctionTableTest, Erase);
+    TEST_RUN(FunctionTableTest, Relocate_Target);
+    TEST_RUN(FunctionTableTest, Value_Argument);
+    TEST_RUN(FunctionTableTest, Rvalue_Argument);
+}
+
+static void testUse__table_double(int& acc) { acc *= 2; }
+
+TEST(FunctionTableTest, Push_Invoke) {
+    using table_t = embed::function_table<void(int&), 8, 3>;
+    static table_t table;
+
+    ASSERT_EQ(table.empty(), true, "%d");
+    ASSERT_EQ(table_t::capacity(), (std::size_t)3, "%zu");
+
+    int k = 5;
+    ASSERT_EQ(table.push_back([k](int& acc) { acc += k; }), true, "%d");
+    ASSERT_EQ(table.push_back(testUse__table_double), true, "%d");
+
+    // An empty embed::Fn is not added.
+    ASSERT_EQ(table.push_back(nullptr), false, "%d");
+    ASSERT_EQ(table.size(), (std::size_t)2, "%zu");
+
+    ASSERT_EQ(table.push_back([](int& acc) { acc -= 1; }), true, "%d");
+
+    // Full.
+    ASSERT_EQ(table.push_back(testUse__table_double), false, "%d");
+
+    // In order: (1 + 5) * 2 - 1
+    int acc = 1;
+    table.invoke_all(acc);
+    ASSERT_EQ(acc, 11, "%d");
+
+    acc = 3;
+    table.invoke(1, acc);
+    ASSERT_EQ(acc, 6, "%d");
+
+    table.clear();
+    ASSERT_EQ(table.empty(), true, "%d");
+
+    return 0;
+}
+
+TEST(FunctionTableTest, Invoke_Range) {
+    // Sweep a part of the table, then the whole table.
+    static embed::function_table<int(int), 8, 64> table;
+    static int hits[64];
+
+    for (int i = 0; i < 64; ++i)
+        table.push_back([i](int a) { hits[i] += a; return i; });
+
+    table.invoke_range(10, 50, 2);
+    int sum = 0;
+    for (int i = 0; i < 64; ++i)
+        sum += hits[i];
+    ASSERT_EQ(sum, 40 * 2, "%d");
+    ASSERT_EQ(hits[9] + hits[50], 0, "%d");
+    ASSERT_EQ(hits[10] + hits[49], 4, "%d");
+
+    table.invoke_all(1);
+    ASSERT_EQ(hits[0] + hits[63], 2, "%d");
+    ASSERT_EQ(table.invoke(63, 0), 63, "%d");
+
+    return 0;
+}
+
+TEST(FunctionTableTest, Erase) {
+    embed::function_table<int(int), 8, 4> table;
+
+    for (int i = 0; i < 4; ++i)
+        table.push_back([i](int a) { return a * 10 + i; });
+
+    // The last entry is moved into the hole.
+    table.erase(1);
+    ASSERT_EQ(table.size(), (std::size_t)3, "%zu");
+    ASSERT_EQ(table.invoke(1, 0), 3, "%d");
+
+    table.erase(2);
+    ASSERT_EQ(table.size(), (std::size_t)2, "%zu");
+    ASSERT_EQ(table.invoke(0, 1), 10, "%d");
+    ASSERT_EQ(table.invoke(1, 1), 13, "%d");
+
+    table.pop_back();
+    ASSERT_EQ(table.size(), (std::size_t)1, "%zu");
+
+    return 0;
+}
+
+TEST(FunctionTableTest, Relocate_Target) {
+    {
+        embed::function_table<int(int), 8, 4> table;
+        table.push_back(testUse__Counter(1));
+        table.push_back(testUse__Counter(2));
+        table.push_back(testUse__Counter(3));
+        ASSERT_EQ(testUse__Counter::alive(), 3, "%d");
+
+        // The last target is relocated, not copied.
+        table.erase(0);
+        ASSERT_EQ(testUse__Counter::alive(), 2, "%d");
+
+        ASSERT_EQ(table.invoke(0, 0), 3, "%d");
+        ASSERT_EQ(table.invoke(1, 0), 2, "%d");
+
+        embed::function<int(int), 8> fn = testUse__Counter(4);
+        ASSERT_EQ(table.push_back(std::move(fn)), true, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 3, "%d");
+        ASSERT_EQ(static_cast<bool>(fn), false, "%d");
+    }
+    ASSERT_EQ(testUse__Counter::alive(), 0, "%d");
+
+    return 0;
+}
+
+TEST(FunctionTableTest, Value_Argument) {
+#if !defined(EMBED_NO_STD_HEADER)
+    // A by-value argument that is not passed by value through the invoker.
+    embed::function_table<void(std::string), 16, 4> table;
+    static std::string joined;
+
+    // Each entry takes its own copy, so moving from it is not observed.
+    table.push_back([](std::string s) { std::string t(std::move(s)); joined += t; });
+    table.push_back([](std::string s) { joined += s; });
+
+    table.invoke_all(std::string("ab"));
+    ASSERT_EQ(joined == "abab", true, "%d");
+
+    std::string s = "c";
+    table.invoke(1, s);
+    table.invoke_range(0, 1, s);
+    ASSERT_EQ(joined == "ababcc", true, "%d");
+    ASSERT_EQ(s == "c", true, "%d");
+#endif
+
+    return 0;
+}
+
+TEST(FunctionTableTest, Rvalue_Argument) {
+#if !defined(EMBED_NO_STD_HEADER)
+    // Every entry moves from its argument, and still gets the value.
+    embed::function_table<void(std::string&&), 16, 4> table;
+    static std::string got[3];
+
+    table.push_back([](std::string&& s) { got[0] = std::move(s); });
+    table.push_back([](std::string&& s) { got[1] = std::move(s); });
+    table.push_back([](std::string&& s) { got[2] = std::move(s); });
+
+    table.invoke_all(std::string("moved"));
+    ASSERT_EQ(got[0] == "moved" && got[1] == "moved" && got[2] == "moved", true, "%d");
+
+    // A single call passes the argument on, without a copy.
+    std::string s = "once";
+    table.invoke(1, std::move(s));
+    ASSERT_EQ(got[1] == "once" && s.empty(), true, "%d");
+#endif
+
+    return 0;
+}
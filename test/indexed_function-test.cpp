@@ -0,0 +1,120 @@
+/**
+ * Here is the test for `embed::compact_indexed_function`.
+ */
+#include "embed/embed_function.hpp"
+#include "test.hpp"
+
+TEST_FUNCTION_DECLARE(IndexedFunctionTest, Layout);
+TEST_FUNCTION_DECLARE(IndexedFunctionTest, Invoke);
+TEST_FUNCTION_DECLARE(IndexedFunctionTest, Lifecycle);
+TEST_FUNCTION_DECLARE(IndexedFunctionTest, Move_Only);
+
+TEST_SUBSYS(IndexedFunctionTest, main) {
+    TEST_RUN(IndexedFunctionTest, Layout);
+    TEST_RUN(IndexedFunctionTest, Invoke);
+    TEST_RUN(IndexedFunctionTest, Lifecycle);
+    TEST_RUN(IndexedFunctionTest, Move_Only);
+}
+
+struct testUse__IndexedMoveOnly {
+    int k;
+
+    explicit testUse__IndexedMoveOnly(int v) noexcept : k(v) {}
+    testUse__IndexedMoveOnly(testUse__IndexedMoveOnly&& o) noexcept : k(o.k) {}
+    testUse__IndexedMoveOnly(const testUse__IndexedMoveOnly&) = delete;
+
+    int operator()() noexcept { return k++; }
+};
+
+// The index of the manager, stored after the buffer.
+template <typename Index, typename IndexedFn>
+static unsigned testUse__index_of(const IndexedFn& fn) {
+    Index index = 0;
+    const unsigned char* bytes =
+        reinterpret_cast<const unsigned char*>(&fn) + sizeof(fn) - sizeof(Index);
+    for (std::size_t i = 0; i < sizeof(Index); ++i)
+        reinterpret_cast<unsigned char*>(&index)[i] = bytes[i];
+    return static_cast<unsigned>(index);
+}
+
+TEST(IndexedFunctionTest, Layout) {
+    using fn32_t = embed::compact_indexed_function<int(int)>;
+    using fn16_t = embed::compact_indexed_function<int(int), 2, std::uint16_t>;
+
+    ASSERT_EQ(sizeof(fn32_t), (std::size_t)8, "%zu");
+    ASSERT_EQ(sizeof(fn16_t), (std::size_t)4, "%zu");
+    ASSERT_EQ(sizeof(fn32_t) <= sizeof(embed::compact_function<int(int)>), true, "%d");
+
+    return 0;
+}
+
+TEST(IndexedFunctionTest, Invoke) {
+    int k = 3;
+    embed::compact_indexed_function<int(int) const> fn1 = [k](int a) { return a * k; };
+    embed::compact_indexed_function<int(int) const> fn2 = [](int a) { return -a; };
+    embed::compact_indexed_function<int(int) const, 2, std::uint16_t> fn3 = [](int a) { return a + 1; };
+    ASSERT_EQ(fn1(2), 6, "%d");
+    ASSERT_EQ(fn2(2), -2, "%d");
+    ASSERT_EQ(fn3(2), 3, "%d");
+
+    // Reassign the same target type, and the index stays the same.
+    auto identity = [](int a) { return a; };
+    fn1 = identity;
+    unsigned index = testUse__index_of<std::uint32_t>(fn1);
+    ASSERT_EQ(index != 0, true, "%d");
+    ASSERT_EQ(index != testUse__index_of<std::uint32_t>(fn2), true, "%d");
+    fn1 = identity;
+    fn2 = fn1;
+    ASSERT_EQ(testUse__index_of<std::uint32_t>(fn1), index, "%u");
+    ASSERT_EQ(testUse__index_of<std::uint32_t>(fn2), index, "%u");
+    ASSERT_EQ(fn1(5), 5, "%d");
+    ASSERT_EQ(fn2(5), 5, "%d");
+
+    embed::compact_indexed_function<int(int) const> empty;
+    ASSERT_EQ(empty == nullptr, true, "%d");
+    ASSERT_EQ(fn1 != nullptr, true, "%d");
+    fn1 = nullptr;
+    ASSERT_EQ(static_cast<bool>(fn1), false, "%d");
+
+    return 0;
+}
+
+TEST(IndexedFunctionTest, Lifecycle) {
+    {
+        embed::compact_indexed_function<int(int)> fn1 = testUse__Counter(2);
+        ASSERT_EQ(testUse__Counter::alive(), 1, "%d");
+
+        embed::compact_indexed_function<int(int)> fn2 = fn1;
+        ASSERT_EQ(testUse__Counter::alive(), 2, "%d");
+
+        embed::compact_indexed_function<int(int)> fn3 = std::move(fn2);
+        ASSERT_EQ(testUse__Counter::alive(), 2, "%d");
+        ASSERT_EQ(fn2 == nullptr, true, "%d");
+        ASSERT_EQ(fn3(4), 6, "%d");
+
+        fn2.emplace<testUse__Counter>(5);
+        fn2.swap(fn3);
+        ASSERT_EQ(fn2(1), 3, "%d");
+        ASSERT_EQ(fn3(1), 6, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 3, "%d");
+
+        fn1 = fn3;
+        ASSERT_EQ(fn1(2), 7, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 3, "%d");
+    }
+    ASSERT_EQ(testUse__Counter::alive(), 0, "%d");
+
+    return 0;
+}
+
+TEST(IndexedFunctionTest, Move_Only) {
+#if !defined(EMBED_NO_NONCOPYABLE_FUNCTOR)
+    embed::compact_indexed_function<int()> fn1 = testUse__IndexedMoveOnly(7);
+    embed::compact_indexed_function<int()> fn2 = std::move(fn1);
+    ASSERT_EQ(fn2(), 7, "%d");
+    ASSERT_EQ(fn2(), 8, "%d");
+    ASSERT_EQ(fn1 == nullptr, true, "%d");
+#endif
+
+    return 0;
+}
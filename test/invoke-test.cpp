@@ -8,6 +8,9 @@ TEST_FUNCTION_DECLARE(InvokeTest, MemberLambdaInvokeTest);
 TEST_FUNCTION_DECLARE(InvokeTest, DiamondInheritanceTset);
 TEST_FUNCTION_DECLARE(InvokeTest, VirtualMethodTest);
 TEST_FUNCTION_DECLARE(InvokeTest, CVRefQualifierTest);
+TEST_FUNCTION_DECLARE(InvokeTest, ArgumentPassingTest);
+TEST_FUNCTION_DECLARE(InvokeTest, NoexceptSignatureTest);
+TEST_FUNCTION_DECLARE(InvokeTest, ConstexprStatelessTest);
 
 TEST_SUBSYS(InvokeTest, main) {
     TEST_RUN(InvokeTest, AssertSameTest);
@@ -17,6 +20,9 @@ TEST_SUBSYS(InvokeTest, main) {
     TEST_RUN(InvokeTest, DiamondInheritanceTset);
     TEST_RUN(InvokeTest, VirtualMethodTest);
     TEST_RUN(InvokeTest, CVRefQualifierTest);
+    TEST_RUN(InvokeTest, ArgumentPassingTest);
+    TEST_RUN(InvokeTest, NoexceptSignatureTest);
+    TEST_RUN(InvokeTest, ConstexprStatelessTest);
 }
 
 static void testUse__normal_func(void) noexcept { }
@@ -185,3 +191,122 @@ TEST(InvokeTest, CVRefQualifierTest) {
     return 0;
 }
 
+
+struct testUse__SmallPod_ { int a; int b; };
+struct testUse__LargePod_ { int data[16]; };
+
+// Count the copies, must not be passed by value through the invoker.
+struct testUse__CopyCounter_ {
+    int* copies;
+    explicit testUse__CopyCounter_(int* c) noexcept : copies(c) {}
+    testUse__CopyCounter_(const testUse__CopyCounter_& o) noexcept : copies(o.copies) { ++*copies; }
+    testUse__CopyCounter_(testUse__CopyCounter_&& o) noexcept : copies(o.copies) {}
+};
+
+TEST(InvokeTest, ArgumentPassingTest) {
+    // Small trivially copyable: passed by value through the invoker.
+    embed::function<int(int, float, testUse__SmallPod_)> fn1 =
+        [](int a, float f, testUse__SmallPod_ p) { return a + static_cast<int>(f) + p.a * p.b; };
+    ASSERT_EQ(fn1(1, 2.5f, testUse__SmallPod_{3, 4}), 15, "%d");
+
+    // Reference parameters still refer to the caller's object.
+    int value = 1;
+    embed::function<void(int&, const int&)> fn2 = [](int& a, const int& b) { a += b; };
+    fn2(value, value);
+    ASSERT_EQ(value, 2, "%d");
+
+    // Large: passed by reference through the invoker.
+    testUse__LargePod_ large{};
+    large.data[15] = 7;
+    embed::function<int(testUse__LargePod_)> fn3 = [](testUse__LargePod_ l) { return l.data[15]; };
+    ASSERT_EQ(fn3(large), 7, "%d");
+
+    // Non-trivial: copied once into `operator()`, then moved to the target.
+    int copies = 0;
+    embed::function<void(testUse__CopyCounter_)> fn4 = [](testUse__CopyCounter_) {};
+    testUse__CopyCounter_ counter(&copies);
+    fn4(counter);
+    ASSERT_EQ(copies, 1, "%d");
+
+    return 0;
+}
+
+
+#if EMBED_CXX_VERSION >= 201703L
+static int testUse__NoexceptFree_(int a) noexcept { return a + 1; }
+#endif
+
+TEST(InvokeTest, NoexceptSignatureTest) {
+#if EMBED_CXX_VERSION >= 201703L
+    embed::function<int(int) noexcept> fn1 = [](int a) noexcept { return a * 2; };
+    static_assert(noexcept(fn1(1)), "operator() of a noexcept Signature must be noexcept");
+    ASSERT_EQ(fn1(21), 42, "%d");
+
+    embed::function<int(int) const noexcept> fn2 = testUse__NoexceptFree_;
+    static_assert(noexcept(fn2(1)), "operator() of a noexcept Signature must be noexcept");
+    ASSERT_EQ(fn2(1), 2, "%d");
+
+    // Dropping noexcept is allowed (the reverse is rejected at compile time).
+    embed::function<int(int)> fn3 = std::move(fn1);
+    ASSERT_EQ(fn3(2), 4, "%d");
+    ASSERT_EQ(fn1.is_empty(), true, "%d");
+#endif
+    return 0;
+}
+
+#if EMBED_CXX_VERSION >= 202002L
+static constexpr int testUse__constexpr_twice(int a) { return a * 2; }
+
+struct testUse__ConstexprNegate_ {
+    constexpr int operator()(int a) const { return -a; }
+};
+
+// Built by the compiler, no dynamic initialization at startup.
+static constinit embed::function<int(int)> testUse__constinit_table[] = {
+    [](int a) { return a + 1; },
+    testUse__ConstexprNegate_{},
+    embed::nontype<&testUse__constexpr_twice>,
+};
+
+static constexpr int testUse__constexpr_dispatch(int a) {
+    embed::function<int(int)> fn1 = [](int x) { return x * 10; };
+    embed::function<int(int)> fn2 = fn1;
+    embed::function<int(int)> fn3 = std::move(fn2);
+    embed::function<int(int)> fn4;
+    fn4 = fn3;
+    fn4 = nullptr;
+    fn4 = std::move(fn3);
+    return fn1(a) + fn4(a) + (fn2 == nullptr ? 1000 : 0);
+}
+#endif
+
+struct testUse__StatelessSelf_ {
+    const void* operator()() const { return this; }
+};
+
+TEST(InvokeTest, ConstexprStatelessTest) {
+#if EMBED_CXX_VERSION >= 202002L
+    static_assert(testUse__constexpr_dispatch(1) == 1020,
+        "embed::Fn with stateless targets must be usable in constant evaluation");
+
+    constexpr embed::function<int(int) const> fn1 = testUse__ConstexprNegate_{};
+    static_assert(fn1(3) == -3, "constexpr embed::Fn must be invocable at compile time");
+
+    ASSERT_EQ(testUse__constinit_table[0](1), 2, "%d");
+    ASSERT_EQ(testUse__constinit_table[1](1), -1, "%d");
+    ASSERT_EQ(testUse__constinit_table[2](4), 8, "%d");
+
+    // A stateless target of a runtime embed::Fn works as before.
+    int base = 5;
+    testUse__constinit_table[0] = [base](int a) { return a + base; };
+    ASSERT_EQ(testUse__constinit_table[0](1), 6, "%d");
+    testUse__constinit_table[0] = testUse__constinit_table[1];
+    ASSERT_EQ(testUse__constinit_table[0](1), -1, "%d");
+#endif
+
+    // At runtime the stateless target is stored, and that object is called.
+    embed::function<const void*() const> fn_self;
+    const testUse__StatelessSelf_& self = fn_self.emplace<testUse__StatelessSelf_>();
+    ASSERT_EQ(fn_self() == &self, true, "%d");
+    return 0;
+}
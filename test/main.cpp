@@ -7,6 +7,16 @@ TEST_SUBSYS_DECLARE(CreateInstanceFromFunctor, main);
 TEST_SUBSYS_DECLARE(AssignTest, main);
 TEST_SUBSYS_DECLARE(SizeAndTraitsTest, main);
 TEST_SUBSYS_DECLARE(InvokeTest, main);
+TEST_SUBSYS_DECLARE(FunctionRefTest, main);
+TEST_SUBSYS_DECLARE(MoveOnlyFunctionTest, main);
+TEST_SUBSYS_DECLARE(NonnullFunctionTest, main);
+TEST_SUBSYS_DECLARE(OverloadFunctionTest, main);
+TEST_SUBSYS_DECLARE(TrivialFunctionTest, main);
+TEST_SUBSYS_DECLARE(SharedBlockTest, main);
+TEST_SUBSYS_DECLARE(IndexedFunctionTest, main);
+TEST_SUBSYS_DECLARE(CallbackSlotMapTest, main);
+TEST_SUBSYS_DECLARE(FunctionTableTest, main);
+TEST_SUBSYS_DECLARE(SpillPoolTest, main);
 
 int main()
 {
@@ -18,6 +28,16 @@ int main()
     TEST_RUN_SUBSYS(AssignTest, main);
     TEST_RUN_SUBSYS(SizeAndTraitsTest, main);
     TEST_RUN_SUBSYS(InvokeTest, main);
+    TEST_RUN_SUBSYS(FunctionRefTest, main);
+    TEST_RUN_SUBSYS(MoveOnlyFunctionTest, main);
+    TEST_RUN_SUBSYS(NonnullFunctionTest, main);
+    TEST_RUN_SUBSYS(OverloadFunctionTest, main);
+    TEST_RUN_SUBSYS(TrivialFunctionTest, main);
+    TEST_RUN_SUBSYS(SharedBlockTest, main);
+    TEST_RUN_SUBSYS(IndexedFunctionTest, main);
+    TEST_RUN_SUBSYS(CallbackSlotMapTest, main);
+    TEST_RUN_SUBSYS(FunctionTableTest, main);
+    TEST_RUN_SUBSYS(SpillPoolTest, main);
 
     return 0;
 }
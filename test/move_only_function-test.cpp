@@ -0,0 +1,110 @@
+/**
+ * Here is the test for `embed::move_only_function`.
+ */
+#include "embed/embed_function.hpp"
+#include "test.hpp"
+
+TEST_FUNCTION_DECLARE(MoveOnlyFunctionTest, Traits);
+TEST_FUNCTION_DECLARE(MoveOnlyFunctionTest, Move_Only_Target);
+TEST_FUNCTION_DECLARE(MoveOnlyFunctionTest, Move_And_Swap);
+TEST_FUNCTION_DECLARE(MoveOnlyFunctionTest, Lifetime);
+
+TEST_SUBSYS(MoveOnlyFunctionTest, main) {
+    TEST_RUN(MoveOnlyFunctionTest, Traits);
+    TEST_RUN(MoveOnlyFunctionTest, Move_Only_Target);
+    TEST_RUN(MoveOnlyFunctionTest, Move_And_Swap);
+    TEST_RUN(MoveOnlyFunctionTest, Lifetime);
+}
+
+// A callable object which can only be moved.
+struct testUse__MoveOnlyAdder_ {
+    int value;
+    explicit testUse__MoveOnlyAdder_(int v) noexcept : value(v) {}
+    testUse__MoveOnlyAdder_(testUse__MoveOnlyAdder_&& other) noexcept
+        : value(other.value) { other.value = 0; }
+    testUse__MoveOnlyAdder_(const testUse__MoveOnlyAdder_&) = delete;
+    int operator()(int a) const { return a + value; }
+};
+
+TEST(MoveOnlyFunctionTest, Traits) {
+    using mo_t = embed::move_only_function<int(int)>;
+
+#if !defined(EMBED_NO_STD_HEADER)
+    static_assert(!std::is_copy_constructible<mo_t>::value,
+        "embed::move_only_function must not be copy constructible");
+    static_assert(!std::is_copy_assignable<mo_t>::value,
+        "embed::move_only_function must not be copy assignable");
+    static_assert(std::is_nothrow_move_constructible<mo_t>::value
+        && std::is_nothrow_move_assignable<mo_t>::value,
+        "embed::move_only_function must be nothrow movable");
+#endif
+
+    ASSERT_EQ(sizeof(mo_t), sizeof(embed::function<int(int)>), "%zu");
+
+    return 0;
+}
+
+TEST(MoveOnlyFunctionTest, Move_Only_Target) {
+    embed::move_only_function<int(int)> fn = testUse__MoveOnlyAdder_(3);
+    ASSERT_EQ(fn(1), 4, "%d");
+
+    fn = testUse__MoveOnlyAdder_(5);
+    ASSERT_EQ(fn(1), 6, "%d");
+
+    fn.emplace<testUse__MoveOnlyAdder_>(7);
+    ASSERT_EQ(fn(1), 8, "%d");
+
+    embed::move_only_function<int(int)> fn2(
+        embed::in_place_type_t<testUse__MoveOnlyAdder_>{}, 9);
+    ASSERT_EQ(fn2(1), 10, "%d");
+
+    // A copyable target is accepted as well.
+    fn = [](int a) { return a * 2; };
+    ASSERT_EQ(fn(2), 4, "%d");
+
+    return 0;
+}
+
+TEST(MoveOnlyFunctionTest, Move_And_Swap) {
+    embed::move_only_function<int(int)> fn1 = testUse__MoveOnlyAdder_(1);
+    embed::move_only_function<int(int)> fn2 = [](int a) { return -a; };
+
+    fn1.swap(fn2);
+    ASSERT_EQ(fn1(3), -3, "%d");
+    ASSERT_EQ(fn2(3), 4, "%d");
+
+    std::swap(fn1, fn2);
+    ASSERT_EQ(fn1(3), 4, "%d");
+
+    embed::move_only_function<int(int)> fn3 = std::move(fn1);
+    ASSERT_EQ(fn1 == nullptr, true, "%d");
+    ASSERT_EQ(fn3(3), 4, "%d");
+
+    fn1 = std::move(fn3);
+    ASSERT_EQ(fn3 == nullptr, true, "%d");
+    ASSERT_EQ(fn1(3), 4, "%d");
+
+    return 0;
+}
+
+TEST(MoveOnlyFunctionTest, Lifetime) {
+    {
+        embed::move_only_function<int(int)> fn1 = testUse__MoveOnlyCounter(0);
+        ASSERT_EQ(testUse__Counter::alive(), 1, "%d");
+
+        embed::move_only_function<int(int)> fn2 = std::move(fn1);
+        ASSERT_EQ(testUse__Counter::alive(), 1, "%d");
+
+        fn2.swap(fn1);
+        ASSERT_EQ(testUse__Counter::alive(), 1, "%d");
+
+        fn1 = nullptr;
+        ASSERT_EQ(testUse__Counter::alive(), 0, "%d");
+
+        fn2.emplace<testUse__MoveOnlyCounter>(0);
+        ASSERT_EQ(testUse__Counter::alive(), 1, "%d");
+    }
+    ASSERT_EQ(testUse__Counter::alive(), 0, "%d");
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * Here is the test for `embed::nonnull_function`.
+ */
+#include "embed/embed_function.hpp"
+#include "test.hpp"
+
+TEST_FUNCTION_DECLARE(NonnullFunctionTest, Traits);
+TEST_FUNCTION_DECLARE(NonnullFunctionTest, Construct);
+TEST_FUNCTION_DECLARE(NonnullFunctionTest, From_Fn);
+TEST_FUNCTION_DECLARE(NonnullFunctionTest, Copy_Move_Swap);
+
+TEST_SUBSYS(NonnullFunctionTest, main) {
+    TEST_RUN(NonnullFunctionTest, Traits);
+    TEST_RUN(NonnullFunctionTest, Construct);
+    TEST_RUN(NonnullFunctionTest, From_Fn);
+    TEST_RUN(NonnullFunctionTest, Copy_Move_Swap);
+}
+
+static int testUse__nonnull_add_one(int a) { return a + 1; }
+
+TEST(NonnullFunctionTest, Traits) {
+    using nn_t = embed::nonnull_function<int(int)>;
+
+#if !defined(EMBED_NO_STD_HEADER)
+    static_assert(!std::is_default_constructible<nn_t>::value,
+        "embed::nonnull_function must not be default constructible");
+    static_assert(!std::is_constructible<nn_t, std::nullptr_t>::value,
+        "embed::nonnull_function must not be constructible from nullptr");
+    static_assert(!std::is_convertible<embed::function<int(int)>, nn_t>::value,
+        "the conversion from embed::Fn must be explicit");
+#endif
+
+    ASSERT_EQ(sizeof(nn_t), sizeof(embed::function<int(int)>), "%zu");
+
+    return 0;
+}
+
+TEST(NonnullFunctionTest, Construct) {
+    embed::nonnull_function<int(int)> fn1 = testUse__nonnull_add_one;
+    ASSERT_EQ(fn1(1), 2, "%d");
+
+    embed::nonnull_function<int(int) const> fn2 = [](int a) { return a * 2; };
+    ASSERT_EQ(fn2(3), 6, "%d");
+
+    embed::nonnull_function<int(int)> fn3(
+        embed::in_place_type_t<testUse__Counter>{}, 4);
+    ASSERT_EQ(fn3(1), 5, "%d");
+
+    fn3 = testUse__nonnull_add_one;
+    ASSERT_EQ(fn3(1), 2, "%d");
+    ASSERT_EQ(testUse__Counter::alive(), 0, "%d");
+
+    return 0;
+}
+
+TEST(NonnullFunctionTest, From_Fn) {
+    embed::function<int(int)> fn = [](int a) { return -a; };
+
+    // Checked once here.
+    embed::nonnull_function<int(int)> nn1(fn);
+    ASSERT_EQ(nn1(2), -2, "%d");
+    ASSERT_EQ(fn(2), -2, "%d");
+
+    embed::nonnull_function<int(int)> nn2(std::move(fn));
+    ASSERT_EQ(nn2(3), -3, "%d");
+    ASSERT_EQ(fn == nullptr, true, "%d");
+
+    return 0;
+}
+
+TEST(NonnullFunctionTest, Copy_Move_Swap) {
+    {
+        embed::nonnull_function<int(int)> fn1 = testUse__Counter(10);
+        embed::nonnull_function<int(int)> fn2 = testUse__nonnull_add_one;
+        ASSERT_EQ(testUse__Counter::alive(), 1, "%d");
+
+        fn1.swap(fn2);
+        ASSERT_EQ(fn1(1), 2, "%d");
+        ASSERT_EQ(fn2(1), 11, "%d");
+
+        std::swap(fn1, fn2);
+        ASSERT_EQ(fn1(1), 11, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 1, "%d");
+
+        embed::nonnull_function<int(int)> fn3 = fn1;
+        ASSERT_EQ(fn3(0), 10, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 2, "%d");
+
+        // The moved-from `fn1` holds nothing.
+        embed::nonnull_function<int(int)> fn4 = std::move(fn1);
+        ASSERT_EQ(fn4(0), 10, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 2, "%d");
+
+        fn1 = fn2;
+        ASSERT_EQ(fn1(0), 1, "%d");
+
+        fn4 = std::move(fn1);
+        ASSERT_EQ(fn4(0), 1, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 1, "%d");
+
+        fn4.emplace<testUse__Counter>(20);
+        ASSERT_EQ(fn4(0), 20, "%d");
+        ASSERT_EQ(testUse__Counter::alive(), 2, "%d");
+    }
+    ASSERT_EQ(testUse__Counter::alive(), 0, "%d");
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * Here is the test for `embed::overload_function`.
+ */
+#include "embed/embed_function.hpp"
+#include "test.hpp"
+
+TEST_FUNCTION_DECLARE(OverloadFunctionTest, Layout);
+TEST_FUNCTION_DECLARE(OverloadFunctionTest, Dispatch);
+TEST_FUNCTION_DECLARE(OverloadFunctionTest, Qualifier);
+TEST_FUNCTION_DECLARE(OverloadFunctionTest, Lifetime);
+
+TEST_SUBSYS(OverloadFunctionTest, main) {
+    TEST_RUN(OverloadFunctionTest, Layout);
+    TEST_RUN(OverloadFunctionTest, Dispatch);
+    TEST_RUN(OverloadFunctionTest, Qualifier);
+    TEST_RUN(OverloadFunctionTest, Lifetime);
+}
+
+struct testUse__OverloadMsg_ {
+    int id;
+};
+
+// A visitor-like functor with several `operator()`.
+struct testUse__OverloadVisitor_ {
+    int* sink;
+    int operator()(int v) const { return *sink += v; }
+    int operator()(float v) const { return *sink += static_cast<int>(v * 10); }
+    int operator()(const testUse__OverloadMsg_& m) const { return *sink += m.id * 100; }
+};
+
+TEST(OverloadFunctionTest, Layout) {
+    using ov_t = embed::overload_function<sizeof(void*),
+        int(int) const, int(float) const, int(const testUse__OverloadMsg_&) const>;
+
+    // One buffer and one table, no matter how many Signatures.
+    ASSERT_EQ(sizeof(ov_t), 2 * sizeof(void*), "%zu");
+    ASSERT_EQ(static_cast<int>(ov_t::signature_count), 3, "%d");
+
+    ov_t fn;
+    ASSERT_EQ(fn == nullptr, true, "%d");
+
+    return 0;
+}
+
+TEST(OverloadFunctionTest, Dispatch) {
+    int sink = 0;
+    embed::overload_function<sizeof(void*),
+        int(int) const, int(float) const, int(const testUse__OverloadMsg_&) const
+    > fn = testUse__OverloadVisitor_{&sink};
+
+    ASSERT_EQ(static_cast<bool>(fn), true, "%d");
+    ASSERT_EQ(fn(1), 1, "%d");
+    ASSERT_EQ(fn(2.5f), 26, "%d");
+    ASSERT_EQ(fn(testUse__OverloadMsg_{3}), 326, "%d");
+
+    fn = nullptr;
+    ASSERT_EQ(fn == nullptr, true, "%d");
+
+    return 0;
+}
+
+struct testUse__OverloadQualified_ {
+    int operator()(int a) & { return a; }
+    int operator()(int a) && { return -a; }
+    int operator()() const noexcept { return 7; }
+};
+
+TEST(OverloadFunctionTest, Qualifier) {
+    embed::overload_function<1, int(int) &, int(int) &&, int() const> fn =
+        testUse__OverloadQualified_{};
+
+    ASSERT_EQ(fn(3), 3, "%d");
+    ASSERT_EQ(std::move(fn)(3), -3, "%d");
+    ASSERT_EQ(fn(), 7, "%d");
+
+#if EMBED_CXX_VERSION >= 201703L
+    embed::overload_function<1, int(int) &, int() const noexcept> fn2 =
+        testUse__OverloadQualified_{};
+    static_assert(noexcept(fn2()), "operator() of a noexcept Signature must be noexcept");
+    ASSERT_EQ(fn2(), 7, "%d");
+#endif
+
+    return 0;
+}
+
+TEST(OverloadFunctionTest, Lifetime) {
+    using ov_t = embed::overload_function<1, int(int) const, int(int, int) const>;
+    {
+        ov_t fn1 = testUse__Counter(0);
+        ASSERT_EQ(testUse__Counter::alive(), 1, "%d");
+        ASSERT_EQ(fn1(1, 2), 3, "%d");
+
+        ov_t fn2 = fn1;
+        ASSERT_EQ(testUse__Counter::alive(), 2, "%d");
+
+        ov_t fn3 = std::move(fn1);
+        ASSERT_EQ(testUse__Counter::alive(), 2, "%d");
+        ASSERT_EQ(fn1 == nullptr, true, "%d");
+
+        fn1.swap(fn3);
+        ASSERT_EQ(fn1(4), 4, "%d");
+        ASSERT_EQ(fn3 == nullptr, true, "%d");
+
+        std::swap(fn1, fn3);
+        ASSERT_EQ(fn3(5), 5, "%d");
+
+        fn2 = nullptr;
+        ASSERT_EQ(testUse__Counter::alive(), 1, "%d");
+
+        fn2.emplace<testUse__Counter>(0);
+        ASSERT_EQ(testUse__Counter::alive(), 2, "%d");
+
+        fn3 = fn2;
+        ASSERT_EQ(testUse__Counter::alive(), 2, "%d");
+    }
+    ASSERT_EQ(testUse__Counter::alive(), 0, "%d");
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+/**
+ * Here is the test for `embed::shared_block` and `embed::shared_target`.
+ */
+#include "embed/embed_function.hpp"
+#include "test.hpp"
+#if !defined(EMBED_NO_STD_HEADER)
+# include <atomic>
+#endif
+
+TEST_FUNCTION_DECLARE(SharedBlockTest, Share_Count);
+TEST_FUNCTION_DECLARE(SharedBlockTest, Release_Reuse);
+TEST_FUNCTION_DECLARE(SharedBlockTest, Atomic_Count);
+
+TEST_SUBSYS(SharedBlockTest, main) {
+    TEST_RUN(SharedBlockTest, Share_Count);
+    TEST_RUN(SharedBlockTest, Release_Reuse);
+    TEST_RUN(SharedBlockTest, Atomic_Count);
+}
+
+static int testUse__shared_alive = 0;
+
+// Too large for the buffer of `embed::function<int(int)>`.
+struct testUse__BigTarget {
+    int table[16];
+
+    explicit testUse__BigTarget(int k) noexcept : table() {
+        for (int i = 0; i < 16; ++i) table[i] = i * k;
+        ++testUse__shared_alive;
+    }
+    ~testUse__BigTarget() { --testUse__shared_alive; }
+
+    int operator()(int i) noexcept { return table[i]; }
+};
+
+// Also too large, it returns the sum of all the steps so far.
+struct testUse__BigCounter {
+    int total;
+    int unused[16];
+
+    testUse__BigCounter() noexcept : total(0), unused() {}
+
+    int operator()(int step) noexcept { return total += step; }
+};
+
+TEST(SharedBlockTest, Share_Count) {
+    embed::shared_block<testUse__BigTarget> block;
+    ASSERT_EQ(block.use_count(), (std::size_t)0, "%zu");
+    ASSERT_EQ(sizeof(embed::shared_target<testUse__BigTarget>), sizeof(void*), "%zu");
+
+    {
+        embed::function<int(int)> fn1 = block.emplace(2);
+        ASSERT_EQ(block.use_count(), (std::size_t)1, "%zu");
+        ASSERT_EQ(testUse__shared_alive, 1, "%d");
+
+        // Copy bumps the count, the target is not copied.
+        embed::function<int(int)> fn2 = fn1;
+        embed::function<int(int)> fn3 = block.share();
+        ASSERT_EQ(block.use_count(), (std::size_t)3, "%zu");
+        ASSERT_EQ(testUse__shared_alive, 1, "%d");
+
+        // Move does not change the count.
+        embed::function<int(int)> fn4 = std::move(fn3);
+        ASSERT_EQ(block.use_count(), (std::size_t)3, "%zu");
+
+        ASSERT_EQ(fn1(3), 6, "%d");
+        ASSERT_EQ(fn2(4), 8, "%d");
+        ASSERT_EQ(fn4(5), 10, "%d");
+
+        ASSERT_EQ(block.share().operator()(7), 14, "%d");
+        ASSERT_EQ(block.use_count(), (std::size_t)3, "%zu");
+
+        fn2 = nullptr;
+        ASSERT_EQ(block.use_count(), (std::size_t)2, "%zu");
+    }
+
+    ASSERT_EQ(block.use_count(), (std::size_t)0, "%zu");
+    ASSERT_EQ(testUse__shared_alive, 0, "%d");
+
+    // All the handles call the same target, the state changed through
+    // one handle is seen through the others. (A copy would restart at 0)
+    embed::shared_block<testUse__BigCounter> counter;
+    embed::function<int(int)> fn1 = counter.emplace();
+    embed::function<int(int)> fn2 = fn1;
+    embed::function<int(int)> fn3 = counter.share();
+    ASSERT_EQ(fn1(1), 1, "%d");
+    ASSERT_EQ(fn2(2), 3, "%d");
+    ASSERT_EQ(fn3(3), 6, "%d");
+    ASSERT_EQ(fn1(0), 6, "%d");
+
+    return 0;
+}
+
+TEST(SharedBlockTest, Release_Reuse) {
+    static embed::shared_block<testUse__BigTarget> block;
+
+    embed::function<int(int)> fn = block.emplace(1);
+    fn(1);
+    fn(2);
+    embed::function<int(int)> other = fn;
+    other(3);
+    ASSERT_EQ(block.share().operator()(15), 15, "%d");
+
+    // The last handle destroys the target, the block can be reused.
+    fn = nullptr;
+    ASSERT_EQ(testUse__shared_alive, 1, "%d");
+    other = nullptr;
+    ASSERT_EQ(testUse__shared_alive, 0, "%d");
+
+    fn = block.emplace(3);
+    ASSERT_EQ(fn(2), 6, "%d");
+    fn = nullptr;
+    ASSERT_EQ(testUse__shared_alive, 0, "%d");
+
+    return 0;
+}
+
+TEST(SharedBlockTest, Atomic_Count) {
+#if !defined(EMBED_NO_STD_HEADER)
+    using block_t = embed::shared_block<testUse__BigTarget, std::atomic<std::size_t>>;
+    block_t block;
+    {
+        embed::function<int(int)> fn1 = block.emplace(5);
+        embed::function<int(int)> fn2 = fn1;
+        ASSERT_EQ(block.use_count(), (std::size_t)2, "%zu");
+        ASSERT_EQ(fn2(1), 5, "%d");
+    }
+    ASSERT_EQ(block.use_count(), (std::size_t)0, "%zu");
+    ASSERT_EQ(testUse__shared_alive, 0, "%d");
+#endif
+
+    return 0;
+}
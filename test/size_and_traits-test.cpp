@@ -6,6 +6,10 @@ TEST_FUNCTION_DECLARE(SizeAndTraitsTest, NoThrowDefaultConstructibleTest);
 TEST_FUNCTION_DECLARE(SizeAndTraitsTest, NoThrowCopyConstructibleTest);
 TEST_FUNCTION_DECLARE(SizeAndTraitsTest, NoThrowMoveConstructibleTest);
 TEST_FUNCTION_DECLARE(SizeAndTraitsTest, NoThrowSwap);
+TEST_FUNCTION_DECLARE(SizeAndTraitsTest, FastAndCompactLayout);
+TEST_FUNCTION_DECLARE(SizeAndTraitsTest, StatelessLayout);
+TEST_FUNCTION_DECLARE(SizeAndTraitsTest, OverAlignedLayout);
+TEST_FUNCTION_DECLARE(SizeAndTraitsTest, SharedLifecycle);
 
 TEST_SUBSYS(SizeAndTraitsTest, main) {
     TEST_RUN(SizeAndTraitsTest, LayoutMatch);
@@ -13,6 +17,10 @@ TEST_SUBSYS(SizeAndTraitsTest, main) {
     TEST_RUN(SizeAndTraitsTest, NoThrowCopyConstructibleTest);
     TEST_RUN(SizeAndTraitsTest, NoThrowMoveConstructibleTest);
     TEST_RUN(SizeAndTraitsTest, NoThrowSwap);
+    TEST_RUN(SizeAndTraitsTest, FastAndCompactLayout);
+    TEST_RUN(SizeAndTraitsTest, StatelessLayout);
+    TEST_RUN(SizeAndTraitsTest, OverAlignedLayout);
+    TEST_RUN(SizeAndTraitsTest, SharedLifecycle);
 }
 
 TEST(SizeAndTraitsTest, LayoutMatch) {
@@ -91,3 +99,183 @@ TEST(SizeAndTraitsTest, NoThrowSwap) {
 
     return 0;
 }
+
+static int testUse__layout_free_func(int a) { return a * 3; }
+
+TEST(SizeAndTraitsTest, FastAndCompactLayout) {
+    using fast_t = embed::fast_function<int(int)>;
+    using compact_t = embed::compact_function<int(int)>;
+    int base = 10;
+
+    // Both layouts coexist in one translation unit.
+    ASSERT_EQ(fast_t::is_fast_mode, true, "%d");
+    ASSERT_EQ(compact_t::is_fast_mode, false, "%d");
+    ASSERT_EQ(sizeof(fast_t), 3 * sizeof(void*), "%zu");
+    ASSERT_EQ(sizeof(compact_t), 2 * sizeof(void*), "%zu");
+
+    fast_t fast = testUse__layout_free_func;
+    compact_t compact = [base](int a) { return a + base; };
+    ASSERT_EQ(fast(2), 6, "%d");
+    ASSERT_EQ(compact(2), 12, "%d");
+
+    // Convert to each other. (copy / move / assign)
+    compact_t compact2 = fast;
+    fast_t fast2 = compact;
+    ASSERT_EQ(compact2(1), 3, "%d");
+    ASSERT_EQ(fast2(1), 11, "%d");
+
+    fast_t fast3(std::move(compact2));
+    ASSERT_EQ(compact2.is_empty(), true, "%d");
+    ASSERT_EQ(fast3(1), 3, "%d");
+
+    compact2 = std::move(fast2);
+    ASSERT_EQ(fast2.is_empty(), true, "%d");
+    ASSERT_EQ(compact2(1), 11, "%d");
+
+    fast2 = compact2;
+    ASSERT_EQ(fast2(0), 10, "%d");
+
+    // Empty converts to empty.
+    compact_t compact3;
+    fast_t fast4 = compact3;
+    ASSERT_EQ(fast4 == nullptr, true, "%d");
+
+    return 0;
+}
+
+struct testUse__EmptyFunctor_ {
+    int operator()(int a) const { return a * 3; }
+};
+
+struct testUse__RefQualified_ {
+    int operator()(int a) const & { return a + 1; }
+    int operator()(int a) const && { return a + 2; }
+    int operator()(int a) & { return a + 3; }
+    int operator()(int a) && { return a + 4; }
+};
+
+TEST(SizeAndTraitsTest, StatelessLayout) {
+    using stateless_t = embed::stateless_function<int(int)>;
+
+    // Only the invoker is stored.
+    ASSERT_EQ(sizeof(stateless_t), sizeof(void*), "%zu");
+    static_assert(std::is_trivially_copyable<stateless_t>::value,
+        "embed::stateless_function must be trivially copyable");
+
+    stateless_t fn1 = [](int a) { return a + 1; };
+    stateless_t fn2 = testUse__EmptyFunctor_{};
+    stateless_t fn3;
+    ASSERT_EQ(fn1(1), 2, "%d");
+    ASSERT_EQ(fn2(1), 3, "%d");
+    ASSERT_EQ(fn3 == nullptr, true, "%d");
+
+    fn3 = fn1;
+    fn1.swap(fn2);
+    ASSERT_EQ(fn1(2), 6, "%d");
+    ASSERT_EQ(fn2(2), 3, "%d");
+    ASSERT_EQ(fn3(2), 3, "%d");
+
+    fn3 = nullptr;
+    ASSERT_EQ(static_cast<bool>(fn3), false, "%d");
+
+    // It can also be the target of embed::function.
+    embed::function<int(int)> fn4 = fn1;
+    ASSERT_EQ(fn4(3), 9, "%d");
+
+#if EMBED_CXX_VERSION >= 201703L
+    embed::stateless_function<int(int)> fn5 = embed::nontype<&testUse__layout_free_func>;
+    ASSERT_EQ(fn5(2), 6, "%d");
+#endif
+
+    // The target is called with the qualifiers of the Signature.
+    embed::stateless_function<int(int)> fn6 = testUse__RefQualified_{};
+    embed::stateless_function<int(int) const> fn7 = testUse__RefQualified_{};
+    embed::stateless_function<int(int) &&> fn8 = testUse__RefQualified_{};
+    embed::stateless_function<int(int) const &&> fn9 = testUse__RefQualified_{};
+    ASSERT_EQ(fn6(0), 3, "%d");
+    ASSERT_EQ(fn7(0), 1, "%d");
+    ASSERT_EQ(fn8(0), 4, "%d");
+    ASSERT_EQ(fn9(0), 2, "%d");
+
+    return 0;
+}
+
+// Same as a vector register or a cache-line-aligned filter state.
+struct alignas(32) testUse__AlignedState_ {
+    int value[8];
+};
+
+TEST(SizeAndTraitsTest, OverAlignedLayout) {
+    using fn_t = embed::function<int(int), 32, 32>;
+    using fn_wide_t = embed::function<int(int), 64, 32>;
+
+    ASSERT_EQ(alignof(fn_t), static_cast<std::size_t>(32), "%zu");
+    ASSERT_EQ(fn_t::buffer_align, static_cast<std::size_t>(32), "%zu");
+    ASSERT_EQ(embed::function<int(int)>::buffer_align, alignof(void*), "%zu");
+    ASSERT_EQ(fn_t::buffer_size, static_cast<std::size_t>(32), "%zu");
+    using fn_small_t = embed::function<int(int), 1, 16>;
+    ASSERT_EQ(fn_small_t::buffer_size, static_cast<std::size_t>(16), "%zu");
+
+    testUse__AlignedState_ state{};
+    for (int i = 0; i < 8; ++i)
+        state.value[i] = i * 2;
+
+    fn_t fn1 = [state](int a) { return state.value[a]; };
+    fn_t fn2 = fn1;
+    fn_t fn3 = std::move(fn2);
+    ASSERT_EQ(fn1(3), 6, "%d");
+    ASSERT_EQ(fn3(7), 14, "%d");
+
+    fn_t fn4 = [](int a) { return -a; };
+    fn4.swap(fn3);
+    ASSERT_EQ(fn4(1), 2, "%d");
+    ASSERT_EQ(fn3(1), -1, "%d");
+
+    // Widening keeps the alignment, narrowing the alignment does not compile.
+    fn_wide_t fn5 = fn1;
+    ASSERT_EQ(fn5(4), 8, "%d");
+#if !defined(EMBED_NO_STD_HEADER)
+    ASSERT_EQ((std::is_constructible<fn_wide_t, embed::function<int(int), 8> >::value), true, "%d");
+    ASSERT_EQ((std::is_constructible<embed::function<int(int), 64>, fn_t>::value), false, "%d");
+#endif
+
+    return 0;
+}
+
+template <typename Functor>
+using testUse__lifecycle_manager_t = embed::detail::FnToolBox::FnManagerCopyable<
+    int(int), Functor, sizeof(void*), false, false, false, alignof(void*)>;
+
+struct testUse__NonTrivialTarget_ {
+    int k;
+    ~testUse__NonTrivialTarget_() {}
+    int operator()(int a) const noexcept { return a - k; }
+};
+
+TEST(SizeAndTraitsTest, SharedLifecycle) {
+    int k = 2;
+    auto la1 = [k](int a) { return a + k; };
+    auto la2 = [k](int a) { return a * k; };
+    using m1_t = testUse__lifecycle_manager_t<decltype(la1)>;
+    using m2_t = testUse__lifecycle_manager_t<decltype(la2)>;
+    using m3_t = testUse__lifecycle_manager_t<testUse__NonTrivialTarget_>;
+
+    // The trivial targets of one buffer share the lifecycle code,
+    // only the invokers are generated per type.
+    ASSERT_EQ(m1_t::M_table.M_clone == m2_t::M_table.M_clone, true, "%d");
+    ASSERT_EQ(m1_t::M_table.M_relocate == m2_t::M_table.M_relocate, true, "%d");
+    ASSERT_EQ(m1_t::M_table.M_destroy == m2_t::M_table.M_destroy, true, "%d");
+    ASSERT_EQ(m1_t::M_table.M_invoke != m2_t::M_table.M_invoke, true, "%d");
+
+    // The non-trivial target keeps its own.
+    ASSERT_EQ(m1_t::M_table.M_clone != m3_t::M_table.M_clone, true, "%d");
+    ASSERT_EQ(m1_t::M_table.M_destroy != m3_t::M_table.M_destroy, true, "%d");
+
+    // The shared entries still copy the target.
+    embed::function<int(int)> fn1 = la1;
+    embed::function<int(int)> fn2 = fn1;
+    embed::function<int(int)> fn3 = std::move(fn2);
+    ASSERT_EQ(fn3(1), 3, "%d");
+
+    return 0;
+}
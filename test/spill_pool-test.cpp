@@ -0,0 +1,147 @@
+/**
+ * Here is the test for `embed::spill_function` and `embed::fixed_block_pool`.
+ */
+#include "embed/embed_function.hpp"
+#include "test.hpp"
+
+TEST_FUNCTION_DECLARE(SpillPoolTest, Inline_And_Spill);
+TEST_FUNCTION_DECLARE(SpillPoolTest, Copy_Move);
+TEST_FUNCTION_DECLARE(SpillPoolTest, Move_Only_Target);
+TEST_FUNCTION_DECLARE(SpillPoolTest, Pool_Blocks);
+
+TEST_SUBSYS(SpillPoolTest, main) {
+    TEST_RUN(SpillPoolTest, Inline_And_Spill);
+    TEST_RUN(SpillPoolTest, Copy_Move);
+    TEST_RUN(SpillPoolTest, Move_Only_Target);
+    TEST_RUN(SpillPoolTest, Pool_Blocks);
+}
+
+using testUse__spill_pool = embed::fixed_block_pool<64, 4>;
+
+template <typename Signature>
+using testUse__spill_fn = embed::spill_function<Signature, 8, testUse__spill_pool>;
+
+static int testUse__spill_alive = 0;
+
+// Too large for the buffer of `testUse__spill_fn<int(int)>`.
+struct testUse__SpillTarget {
+    int table[10];
+
+    explicit testUse__SpillTarget(int k) noexcept : table() {
+        for (int i = 0; i < 10; ++i) table[i] = i * k;
+        ++testUse__spill_alive;
+    }
+    testUse__SpillTarget(const testUse__SpillTarget& other) noexcept : table() {
+        for (int i = 0; i < 10; ++i) table[i] = other.table[i];
+        ++testUse__spill_alive;
+    }
+    ~testUse__SpillTarget() { --testUse__spill_alive; }
+
+    int operator()(int i) const noexcept { return table[i]; }
+};
+
+struct testUse__SpillMoveOnly {
+    int table[10];
+
+    testUse__SpillMoveOnly() noexcept : table() { table[9] = 9; }
+    testUse__SpillMoveOnly(testUse__SpillMoveOnly&&) = delete;
+    testUse__SpillMoveOnly(const testUse__SpillMoveOnly&) = delete;
+
+    int operator()() noexcept { return table[9]++; }
+};
+
+TEST(SpillPoolTest, Inline_And_Spill) {
+    int k = 3;
+    {
+        // The small target stays in the buffer.
+        testUse__spill_fn<int(int)> small = [k](int a) { return a * k; };
+        ASSERT_EQ(testUse__spill_pool::in_use(), (std::size_t)0, "%zu");
+        ASSERT_EQ(small(2), 6, "%d");
+
+        // The oversized target is placed in the pool.
+        testUse__spill_fn<int(int) const> big = testUse__SpillTarget(2);
+        ASSERT_EQ(testUse__spill_pool::in_use(), (std::size_t)1, "%zu");
+        ASSERT_EQ(testUse__spill_alive, 1, "%d");
+        ASSERT_EQ(big(4), 8, "%d");
+
+        testUse__SpillTarget& target = big.emplace<testUse__SpillTarget>(5);
+        ASSERT_EQ(testUse__spill_pool::in_use(), (std::size_t)1, "%zu");
+        target.table[1] = 42;
+        ASSERT_EQ(big(1), 42, "%d");
+    }
+    ASSERT_EQ(testUse__spill_pool::in_use(), (std::size_t)0, "%zu");
+    ASSERT_EQ(testUse__spill_alive, 0, "%d");
+
+    return 0;
+}
+
+TEST(SpillPoolTest, Copy_Move) {
+    {
+        testUse__spill_fn<int(int)> fn1 = testUse__SpillTarget(1);
+
+        // Copy takes a new block, the target is copied.
+        testUse__spill_fn<int(int)> fn2 = fn1;
+        ASSERT_EQ(testUse__spill_pool::in_use(), (std::size_t)2, "%zu");
+        ASSERT_EQ(testUse__spill_alive, 2, "%d");
+
+        // Move steals the block.
+        testUse__spill_fn<int(int)> fn3 = std::move(fn2);
+        ASSERT_EQ(testUse__spill_pool::in_use(), (std::size_t)2, "%zu");
+        ASSERT_EQ(fn3(7), 7, "%d");
+
+        fn1.swap(fn3);
+        ASSERT_EQ(testUse__spill_pool::in_use(), (std::size_t)2, "%zu");
+        ASSERT_EQ(fn1(6), 6, "%d");
+
+        fn3 = nullptr;
+        ASSERT_EQ(testUse__spill_pool::in_use(), (std::size_t)1, "%zu");
+    }
+    ASSERT_EQ(testUse__spill_pool::in_use(), (std::size_t)0, "%zu");
+    ASSERT_EQ(testUse__spill_alive, 0, "%d");
+    ASSERT_EQ(testUse__spill_pool::high_water_mark() >= 2, true, "%d");
+
+    return 0;
+}
+
+TEST(SpillPoolTest, Move_Only_Target) {
+#if !defined(EMBED_NO_NONCOPYABLE_FUNCTOR)
+    {
+        // Built in place, then only the handle is moved.
+        testUse__spill_fn<int()> fn1;
+        fn1.emplace<testUse__SpillMoveOnly>();
+        testUse__spill_fn<int()> fn2 = std::move(fn1);
+        ASSERT_EQ(fn2(), 9, "%d");
+        ASSERT_EQ(fn2(), 10, "%d");
+        ASSERT_EQ(testUse__spill_pool::in_use(), (std::size_t)1, "%zu");
+    }
+    ASSERT_EQ(testUse__spill_pool::in_use(), (std::size_t)0, "%zu");
+#endif
+
+    return 0;
+}
+
+TEST(SpillPoolTest, Pool_Blocks) {
+    // 70 blocks span more than one word of the bitmap.
+    using pool_t = embed::fixed_block_pool<24, 70, 8, struct testUse__PoolTag>;
+    static void* blocks[70];
+
+    for (int i = 0; i < 70; ++i) {
+        blocks[i] = pool_t::allocate();
+        ASSERT_EQ(blocks[i] != nullptr, true, "%d");
+    }
+    ASSERT_EQ(pool_t::allocate() == nullptr, true, "%d");
+    ASSERT_EQ(pool_t::in_use(), (std::size_t)70, "%zu");
+    ASSERT_EQ(pool_t::high_water_mark(), (std::size_t)70, "%zu");
+
+    // The freed block is taken again.
+    void* freed = blocks[65];
+    pool_t::deallocate(freed);
+    ASSERT_EQ(pool_t::allocate() == freed, true, "%d");
+
+    for (int i = 0; i < 70; ++i)
+        pool_t::deallocate(blocks[i]);
+    ASSERT_EQ(pool_t::in_use(), (std::size_t)0, "%zu");
+    ASSERT_EQ(pool_t::high_water_mark(), (std::size_t)70, "%zu");
+
+    return 0;
+}
@@ -140,5 +140,33 @@ public:
   virtual ~testUse__Base2() = default;
 };
 
+// Counts the live copies, to check that a wrapper relocates, copies and
+// destroys its target. Not trivial, but as small as an `int`.
+struct testUse__Counter {
+  int k;
+
+  static int& alive() noexcept { static int count = 0; return count; }
+  static int& copies() noexcept { static int count = 0; return count; }
+
+  explicit testUse__Counter(int v) noexcept : k(v) { ++alive(); }
+  testUse__Counter(const testUse__Counter& o) noexcept : k(o.k) { ++alive(); ++copies(); }
+  ~testUse__Counter() { --alive(); }
+
+  int operator()(int a) const noexcept { return a + k; }
+  int operator()(int a, int b) const noexcept { return a + b + k; }
+};
+
+// The move-only `testUse__Counter`, counted by `testUse__Counter::alive()`.
+struct testUse__MoveOnlyCounter {
+  int k;
+
+  explicit testUse__MoveOnlyCounter(int v) noexcept : k(v) { ++testUse__Counter::alive(); }
+  testUse__MoveOnlyCounter(testUse__MoveOnlyCounter&& o) noexcept : k(o.k) { ++testUse__Counter::alive(); }
+  testUse__MoveOnlyCounter(const testUse__MoveOnlyCounter&) = delete;
+  ~testUse__MoveOnlyCounter() { --testUse__Counter::alive(); }
+
+  int operator()(int a) const noexcept { return a + k; }
+};
+
 #endif // TEST_HPP___
 
@@ -0,0 +1,82 @@
+/**
+ * Here is the test for `embed::trivial_function`.
+ */
+#include "embed/embed_function.hpp"
+#include "test.hpp"
+#include <cstring>
+
+TEST_FUNCTION_DECLARE(TrivialFunctionTest, Traits);
+TEST_FUNCTION_DECLARE(TrivialFunctionTest, Raw_Copy);
+TEST_FUNCTION_DECLARE(TrivialFunctionTest, To_Fn);
+
+TEST_SUBSYS(TrivialFunctionTest, main) {
+    TEST_RUN(TrivialFunctionTest, Traits);
+    TEST_RUN(TrivialFunctionTest, Raw_Copy);
+    TEST_RUN(TrivialFunctionTest, To_Fn);
+}
+
+static int testUse__trivial_add_one(int a) { return a + 1; }
+
+TEST(TrivialFunctionTest, Traits) {
+    using tf_t = embed::trivial_function<int(int)>;
+
+#if !defined(EMBED_NO_STD_HEADER)
+    static_assert(std::is_trivially_copyable<tf_t>::value,
+        "embed::trivial_function must be trivially copyable");
+    static_assert(std::is_trivially_destructible<tf_t>::value,
+        "embed::trivial_function must be trivially destructible");
+#endif
+
+    ASSERT_EQ(sizeof(tf_t), sizeof(embed::function<int(int)>), "%zu");
+
+    tf_t fn;
+    ASSERT_EQ(fn == nullptr, true, "%d");
+
+    return 0;
+}
+
+TEST(TrivialFunctionTest, Raw_Copy) {
+    int k = 3;
+    embed::trivial_function<int(int) const> ring[4];
+    embed::trivial_function<int(int) const> fn1 = [k](int a) { return a * k; };
+    embed::trivial_function<int(int) const> fn2 = testUse__trivial_add_one;
+
+    // No lifecycle calls, raw bytes only.
+    memcpy(&ring[0], &fn1, sizeof(fn1));
+    memcpy(&ring[1], &fn2, sizeof(fn2));
+    ASSERT_EQ(ring[0](2), 6, "%d");
+    ASSERT_EQ(ring[1](2), 3, "%d");
+
+    ring[2] = ring[0];
+    ring[2].swap(ring[1]);
+    ASSERT_EQ(ring[1](1), 3, "%d");
+    ASSERT_EQ(ring[2](1), 2, "%d");
+
+    ring[0] = nullptr;
+    ASSERT_EQ(ring[0] == nullptr, true, "%d");
+
+    ring[3] = [](int a) { return -a; };
+    ASSERT_EQ(ring[3](1), -1, "%d");
+
+    return 0;
+}
+
+TEST(TrivialFunctionTest, To_Fn) {
+    int k = 5;
+    embed::trivial_function<int(int)> tf = [k](int a) { return a + k; };
+
+    // Converts into embed::Fn with the same BufSize.
+    embed::function<int(int)> fn = tf;
+    ASSERT_EQ(fn(1), 6, "%d");
+
+    embed::function<int(int)> fn2 = fn;
+    ASSERT_EQ(fn2(2), 7, "%d");
+
+    fn2 = embed::trivial_function<int(int)>(testUse__trivial_add_one);
+    ASSERT_EQ(fn2(2), 3, "%d");
+
+    embed::function<int(int)> fn3 = embed::trivial_function<int(int)>();
+    ASSERT_EQ(fn3 == nullptr, true, "%d");
+
+    return 0;
+}